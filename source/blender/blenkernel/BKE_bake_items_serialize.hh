@@ -24,6 +24,43 @@ struct BlobSlice {
   static std::optional<BlobSlice> deserialize(const io::serialize::DictionaryValue &io_slice);
 };
 
+/**
+ * Encodings that can be applied to data before it is written to a blob.
+ */
+enum class BlobCodec {
+  /** The data is stored as is. */
+  None,
+  /**
+   * The bytes of all elements are reordered so that bytes with the same significance are next to
+   * each other. The result is compressed with zstd.
+   */
+  ZstdShuffle,
+  /** Every byte is a boolean that is stored as a single bit. The result is compressed with zstd. */
+  ZstdBits,
+};
+
+/**
+ * Reference to potentially compressed data in a blob. The data is split into chunks that are
+ * compressed independently so that they can be decoded in parallel.
+ */
+struct CompressedBlobSlice {
+  /** Where the encoded data is stored. */
+  BlobSlice slice;
+  BlobCodec codec = BlobCodec::None;
+  /** Size of the elements whose bytes are reordered by #BlobCodec::ZstdShuffle. */
+  int64_t element_size = 1;
+  /** Size of the data after decoding. */
+  int64_t raw_size = 0;
+  /** Decoded size of every chunk except for the last one which may be smaller. */
+  int64_t chunk_size = 0;
+  /** Encoded size of every chunk. */
+  Vector<int64_t> chunk_sizes;
+
+  std::shared_ptr<io::serialize::DictionaryValue> serialize() const;
+  static std::optional<CompressedBlobSlice> deserialize(
+      const io::serialize::DictionaryValue &io_slice);
+};
+
 /**
  * Abstract base class for loading binary data.
  */
@@ -95,6 +132,12 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   Map<uint64_t, BlobSlice> slice_by_content_hash_;
 
+  /**
+   * Same as above, but for data that is compressed before it is written. The hash is computed
+   * from the uncompressed data and the codec.
+   */
+  Map<uint64_t, CompressedBlobSlice> compressed_slice_by_content_hash_;
+
  public:
   ~BlobWriteSharing();
 
@@ -115,6 +158,18 @@ class BlobWriteSharing : NonCopyable, NonMovable {
    */
   [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated(
       BlobWriter &writer, const void *data, int64_t size_in_bytes);
+
+  /**
+   * Same as #write_deduplicated, but the data is encoded with the given codec before it is
+   * written. If compression does not reduce the size, the data is stored uncompressed.
+   * \param element_size: Size of the elements in the data, used by #BlobCodec::ZstdShuffle.
+   */
+  [[nodiscard]] std::shared_ptr<io::serialize::DictionaryValue> write_deduplicated_compressed(
+      BlobWriter &writer,
+      const void *data,
+      int64_t size_in_bytes,
+      BlobCodec codec,
+      int64_t element_size);
 };
 
 /**
@@ -144,6 +199,17 @@ class BlobReadSharing : NonCopyable, NonMovable {
       FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const;
 };
 
+/**
+ * Read data written by #BlobWriteSharing::write_deduplicated_compressed. The chunks of compressed
+ * data are decoded in parallel.
+ * \param size_in_bytes: Expected size of the decoded data.
+ * \return True on success, otherwise false.
+ */
+[[nodiscard]] bool read_compressed_blob(const BlobReader &blob_reader,
+                                        const CompressedBlobSlice &compressed,
+                                        int64_t size_in_bytes,
+                                        void *r_data);
+
 /**
  * A specific #BlobReader that reads from disk.
  */
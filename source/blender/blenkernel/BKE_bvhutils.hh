@@ -165,8 +165,15 @@ struct BVHTreeFromPointCloud {
   BVHTree_NearestPointCallback nearest_callback;
 
   const float (*coords)[3];
+
+  /* Private data */
+  bool cached;
 };
 
+/**
+ * Build a bvh tree containing the given points. When all points are used, the tree is cached on
+ * the point cloud runtime data.
+ */
 void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
                                      const blender::IndexMask &points_mask,
                                      BVHTreeFromPointCloud &r_data);
@@ -29,6 +29,7 @@ struct SubdivCCG;
 struct SubsurfRuntimeData;
 namespace blender::bke {
 struct EditMeshData;
+struct RemeshVoxelLevelSet;
 }
 namespace blender::bke::bake {
 struct BakeMaterialsList;
@@ -220,6 +221,12 @@ struct MeshRuntime {
   /** Cache of non-manifold boundary data for shrinkwrap target Project. */
   SharedCache<ShrinkwrapBoundaryData> shrinkwrap_boundary_cache;
 
+  /**
+   * Level set of the surface created by the voxel remesher, reused when the unchanged mesh is
+   * remeshed again with the same voxel size. Defined in `mesh_remesh_voxel.cc`.
+   */
+  SharedCache<std::shared_ptr<RemeshVoxelLevelSet>> remesh_voxel_level_set_cache;
+
   /**
    * A bit vector the size of the number of vertices, set to true for the center vertices of
    * subdivided faces. The values are set by the subdivision surface modifier and used by
@@ -13,10 +13,12 @@
 #include "BKE_pointcloud.hh"
 #include "BKE_volume.hh"
 
+#include "BLI_array_utils.hh"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_path_util.h"
+#include "BLI_task.hh"
 
 #include "DNA_material_types.h"
 #include "DNA_volume_types.h"
@@ -24,9 +26,11 @@
 #include "RNA_access.hh"
 #include "RNA_enum_types.hh"
 
+#include <atomic>
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
+#include <zstd.h>
 
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
@@ -61,6 +65,268 @@ std::optional<BlobSlice> BlobSlice::deserialize(const DictionaryValue &io_slice)
   return BlobSlice{*name, {*start, *size}};
 }
 
+/** Decoded size of the chunks that compressed data is split into. */
+static constexpr int64_t compressed_blob_chunk_size = 1 << 20;
+/** Compressing small arrays is not worth the overhead of the additional meta-data. */
+static constexpr int64_t compressed_blob_min_size = 256;
+/** A low level is used because the compression happens while baking. */
+static constexpr int compressed_blob_zstd_level = 3;
+
+static StringRefNull get_blob_codec_io_name(const BlobCodec codec)
+{
+  switch (codec) {
+    case BlobCodec::None:
+      return "none";
+    case BlobCodec::ZstdShuffle:
+      return "zstd_shuffle";
+    case BlobCodec::ZstdBits:
+      return "zstd_bits";
+  }
+  BLI_assert_unreachable();
+  return "none";
+}
+
+static std::optional<BlobCodec> get_blob_codec_from_io_name(const StringRef io_name)
+{
+  if (io_name == "none") {
+    return BlobCodec::None;
+  }
+  if (io_name == "zstd_shuffle") {
+    return BlobCodec::ZstdShuffle;
+  }
+  if (io_name == "zstd_bits") {
+    return BlobCodec::ZstdBits;
+  }
+  return std::nullopt;
+}
+
+std::shared_ptr<DictionaryValue> CompressedBlobSlice::serialize() const
+{
+  auto io_slice = this->slice.serialize();
+  if (this->codec == BlobCodec::None) {
+    return io_slice;
+  }
+  io_slice->append_str("codec", get_blob_codec_io_name(this->codec));
+  io_slice->append_int("element_size", this->element_size);
+  io_slice->append_int("raw_size", this->raw_size);
+  io_slice->append_int("chunk_size", this->chunk_size);
+  auto io_chunk_sizes = io_slice->append_array("chunk_sizes");
+  for (const int64_t size : this->chunk_sizes) {
+    io_chunk_sizes->append_int(int(size));
+  }
+  return io_slice;
+}
+
+std::optional<CompressedBlobSlice> CompressedBlobSlice::deserialize(
+    const DictionaryValue &io_slice)
+{
+  std::optional<BlobSlice> slice = BlobSlice::deserialize(io_slice);
+  if (!slice) {
+    return std::nullopt;
+  }
+  CompressedBlobSlice compressed;
+  compressed.slice = std::move(*slice);
+  compressed.raw_size = compressed.slice.range.size();
+  const std::optional<StringRefNull> codec_name = io_slice.lookup_str("codec");
+  if (!codec_name) {
+    /* Data written by older versions is never compressed. */
+    return compressed;
+  }
+  const std::optional<BlobCodec> codec = get_blob_codec_from_io_name(*codec_name);
+  const std::optional<int64_t> element_size = io_slice.lookup_int("element_size");
+  const std::optional<int64_t> raw_size = io_slice.lookup_int("raw_size");
+  const std::optional<int64_t> chunk_size = io_slice.lookup_int("chunk_size");
+  const ArrayValue *io_chunk_sizes = io_slice.lookup_array("chunk_sizes");
+  if (!codec || !element_size || !raw_size || !chunk_size || !io_chunk_sizes) {
+    return std::nullopt;
+  }
+  if (*element_size <= 0 || *raw_size < 0 || *chunk_size <= 0) {
+    return std::nullopt;
+  }
+  /* Chunks are decoded independently, so they have to contain whole elements. */
+  if (*chunk_size % *element_size != 0) {
+    return std::nullopt;
+  }
+  compressed.codec = *codec;
+  compressed.element_size = *element_size;
+  compressed.raw_size = *raw_size;
+  compressed.chunk_size = *chunk_size;
+  for (const std::shared_ptr<Value> &io_size : io_chunk_sizes->elements()) {
+    const IntValue *size = io_size->as_int_value();
+    if (!size || size->value() < 0) {
+      return std::nullopt;
+    }
+    compressed.chunk_sizes.append(size->value());
+  }
+  return compressed;
+}
+
+static void pack_bits(const Span<uint8_t> src, MutableSpan<uint8_t> dst)
+{
+  dst.fill(0);
+  for (const int64_t i : src.index_range()) {
+    if (src[i]) {
+      dst[i >> 3] |= uint8_t(1 << (i & 7));
+    }
+  }
+}
+
+static void unpack_bits(const Span<uint8_t> src, MutableSpan<uint8_t> dst)
+{
+  for (const int64_t i : dst.index_range()) {
+    dst[i] = (src[i >> 3] >> (i & 7)) & 1;
+  }
+}
+
+static int64_t get_filtered_size(const BlobCodec codec, const int64_t raw_size)
+{
+  if (codec == BlobCodec::ZstdBits) {
+    return (raw_size + 7) / 8;
+  }
+  return raw_size;
+}
+
+/**
+ * Compress the data in independent chunks in parallel and write the result as a single slice.
+ * \return The written slice or none if compression did not reduce the size.
+ */
+static std::optional<CompressedBlobSlice> write_compressed_blob(BlobWriter &blob_writer,
+                                                                const Span<uint8_t> data,
+                                                                const BlobCodec codec,
+                                                                const int64_t element_size)
+{
+  BLI_assert(codec != BlobCodec::None);
+  BLI_assert(data.size() % element_size == 0);
+  /* Chunks have to contain whole elements and whole bytes of packed bits. */
+  const int64_t chunk_size = compressed_blob_chunk_size / element_size * element_size;
+  const int64_t chunks_num = (data.size() + chunk_size - 1) / chunk_size;
+
+  Array<Vector<uint8_t>> compressed_chunks(chunks_num);
+  std::atomic<bool> failed = false;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    ZSTD_CCtx *ctx = ZSTD_createCCtx();
+    Vector<uint8_t> filtered;
+    for (const int64_t chunk_i : range) {
+      const Span<uint8_t> raw_chunk = data.slice(
+          IndexRange::from_begin_end(chunk_i * chunk_size,
+                                     std::min(data.size(), (chunk_i + 1) * chunk_size)));
+      filtered.resize(get_filtered_size(codec, raw_chunk.size()));
+      if (codec == BlobCodec::ZstdBits) {
+        pack_bits(raw_chunk, filtered);
+      }
+      else {
+        array_utils::shuffle_bytes(raw_chunk, element_size, filtered);
+      }
+      Vector<uint8_t> &compressed = compressed_chunks[chunk_i];
+      compressed.resize(ZSTD_compressBound(filtered.size()));
+      const size_t compressed_size = ZSTD_compressCCtx(ctx,
+                                                       compressed.data(),
+                                                       compressed.size(),
+                                                       filtered.data(),
+                                                       filtered.size(),
+                                                       compressed_blob_zstd_level);
+      if (ZSTD_isError(compressed_size)) {
+        failed = true;
+        break;
+      }
+      compressed.resize(compressed_size);
+    }
+    ZSTD_freeCCtx(ctx);
+  });
+  if (failed) {
+    return std::nullopt;
+  }
+
+  CompressedBlobSlice compressed;
+  compressed.codec = codec;
+  compressed.element_size = element_size;
+  compressed.raw_size = data.size();
+  compressed.chunk_size = chunk_size;
+  int64_t compressed_size = 0;
+  for (const Vector<uint8_t> &chunk : compressed_chunks) {
+    compressed.chunk_sizes.append(chunk.size());
+    compressed_size += chunk.size();
+  }
+  if (compressed_size >= data.size()) {
+    return std::nullopt;
+  }
+
+  Array<uint8_t> buffer(compressed_size, NoInitialization());
+  int64_t offset = 0;
+  for (const Vector<uint8_t> &chunk : compressed_chunks) {
+    buffer.as_mutable_span().slice(offset, chunk.size()).copy_from(chunk);
+    offset += chunk.size();
+  }
+  compressed.slice = blob_writer.write(buffer.data(), buffer.size());
+  return compressed;
+}
+
+bool read_compressed_blob(const BlobReader &blob_reader,
+                          const CompressedBlobSlice &compressed,
+                          const int64_t size_in_bytes,
+                          void *r_data)
+{
+  if (compressed.raw_size != size_in_bytes) {
+    return false;
+  }
+  if (compressed.codec == BlobCodec::None) {
+    if (compressed.slice.range.size() != size_in_bytes) {
+      return false;
+    }
+    return blob_reader.read(compressed.slice, r_data);
+  }
+  if (size_in_bytes % compressed.element_size != 0) {
+    return false;
+  }
+  const int64_t chunks_num = (size_in_bytes + compressed.chunk_size - 1) /
+                           compressed.chunk_size;
+  if (compressed.chunk_sizes.size() != chunks_num) {
+    return false;
+  }
+  Array<int64_t> chunk_offsets(chunks_num + 1);
+  chunk_offsets[0] = 0;
+  for (const int64_t chunk_i : IndexRange(chunks_num)) {
+    chunk_offsets[chunk_i + 1] = chunk_offsets[chunk_i] + compressed.chunk_sizes[chunk_i];
+  }
+  if (chunk_offsets.last() != compressed.slice.range.size()) {
+    return false;
+  }
+
+  Array<uint8_t> buffer(compressed.slice.range.size(), NoInitialization());
+  if (!blob_reader.read(compressed.slice, buffer.data())) {
+    return false;
+  }
+
+  const MutableSpan<uint8_t> dst(static_cast<uint8_t *>(r_data), size_in_bytes);
+  std::atomic<bool> failed = false;
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    ZSTD_DCtx *ctx = ZSTD_createDCtx();
+    Vector<uint8_t> filtered;
+    for (const int64_t chunk_i : range) {
+      const Span<uint8_t> src_chunk = buffer.as_span().slice(
+          IndexRange::from_begin_end(chunk_offsets[chunk_i], chunk_offsets[chunk_i + 1]));
+      const MutableSpan<uint8_t> dst_chunk = dst.slice(IndexRange::from_begin_end(
+          chunk_i * compressed.chunk_size,
+          std::min(size_in_bytes, (chunk_i + 1) * compressed.chunk_size)));
+      filtered.resize(get_filtered_size(compressed.codec, dst_chunk.size()));
+      const size_t decompressed_size = ZSTD_decompressDCtx(
+          ctx, filtered.data(), filtered.size(), src_chunk.data(), src_chunk.size());
+      if (ZSTD_isError(decompressed_size) || decompressed_size != size_t(filtered.size())) {
+        failed = true;
+        break;
+      }
+      if (compressed.codec == BlobCodec::ZstdBits) {
+        unpack_bits(filtered, dst_chunk);
+      }
+      else {
+        array_utils::unshuffle_bytes(filtered, compressed.element_size, dst_chunk);
+      }
+    }
+    ZSTD_freeDCtx(ctx);
+  });
+  return !failed;
+}
+
 BlobSlice BlobWriter::write_as_stream(const StringRef /*file_extension*/,
                                       const FunctionRef<void(std::ostream &)> fn)
 {
@@ -199,6 +465,34 @@ std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplic
   return slice.serialize();
 }
 
+std::shared_ptr<io::serialize::DictionaryValue> BlobWriteSharing::write_deduplicated_compressed(
+    BlobWriter &writer,
+    const void *data,
+    const int64_t size_in_bytes,
+    const BlobCodec codec,
+    const int64_t element_size)
+{
+  if (codec == BlobCodec::None || size_in_bytes < compressed_blob_min_size) {
+    return this->write_deduplicated(writer, data, size_in_bytes);
+  }
+  const uint64_t seed = (uint64_t(codec) << 32) | uint64_t(element_size);
+  const uint64_t content_hash = XXH3_64bits_withSeed(data, size_in_bytes, seed);
+  const CompressedBlobSlice &compressed = compressed_slice_by_content_hash_.lookup_or_add_cb(
+      content_hash, [&]() {
+        const Span<uint8_t> span(static_cast<const uint8_t *>(data), size_in_bytes);
+        if (std::optional<CompressedBlobSlice> result = write_compressed_blob(
+                writer, span, codec, element_size))
+        {
+          return std::move(*result);
+        }
+        CompressedBlobSlice uncompressed;
+        uncompressed.slice = writer.write(data, size_in_bytes);
+        uncompressed.raw_size = size_in_bytes;
+        return uncompressed;
+      });
+  return compressed.serialize();
+}
+
 std::optional<ImplicitSharingInfoAndData> BlobReadSharing::read_shared(
     const DictionaryValue &io_data,
     FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const
@@ -273,9 +567,12 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
     const void *data,
-    const int64_t size_in_bytes)
+    const int64_t size_in_bytes,
+    const BlobCodec codec = BlobCodec::None,
+    const int64_t element_size = 1)
 {
-  auto io_data = blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  auto io_data = blob_sharing.write_deduplicated_compressed(
+      blob_writer, data, size_in_bytes, codec, element_size);
   if (ENDIAN_ORDER == B_ENDIAN) {
     io_data->append_str("endian", get_endian_io_name(ENDIAN_ORDER));
   }
@@ -291,14 +588,11 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
                                                          const int64_t elements_num,
                                                          void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  const std::optional<CompressedBlobSlice> slice = CompressedBlobSlice::deserialize(io_data);
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != element_size * elements_num) {
-    return false;
-  }
-  if (!blob_reader.read(*slice, r_data)) {
+  if (!read_compressed_blob(blob_reader, *slice, element_size * elements_num, r_data)) {
     return false;
   }
   const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
@@ -325,12 +619,16 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_data_with_endian(
 }
 
 /** Write bytes ignoring endianness. */
-static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_writer,
-                                                             BlobWriteSharing &blob_sharing,
-                                                             const void *data,
-                                                             const int64_t size_in_bytes)
+static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(
+    BlobWriter &blob_writer,
+    BlobWriteSharing &blob_sharing,
+    const void *data,
+    const int64_t size_in_bytes,
+    const BlobCodec codec = BlobCodec::None,
+    const int64_t element_size = 1)
 {
-  return blob_sharing.write_deduplicated(blob_writer, data, size_in_bytes);
+  return blob_sharing.write_deduplicated_compressed(
+      blob_writer, data, size_in_bytes, codec, element_size);
 }
 
 /** Read bytes ignoring endianness. */
@@ -339,14 +637,11 @@ static std::shared_ptr<DictionaryValue> write_blob_raw_bytes(BlobWriter &blob_wr
                                               const int64_t bytes_num,
                                               void *r_data)
 {
-  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  const std::optional<CompressedBlobSlice> slice = CompressedBlobSlice::deserialize(io_data);
   if (!slice) {
     return false;
   }
-  if (slice->range.size() != bytes_num) {
-    return false;
-  }
-  return blob_reader.read(*slice, r_data);
+  return read_compressed_blob(blob_reader, *slice, bytes_num, r_data);
 }
 
 static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob_writer,
@@ -355,11 +650,15 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
 {
   const CPPType &type = data.type();
   BLI_assert(type.is_trivial());
+  /* Array data is compressed. Shuffling bytes by the full type size also groups the bytes of
+   * the individual components of vector types. */
+  const BlobCodec codec = type.is<bool>() ? BlobCodec::ZstdBits : BlobCodec::ZstdShuffle;
   if (type.size() == 1 || type.is<ColorGeometry4b>()) {
-    return write_blob_raw_bytes(blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+    return write_blob_raw_bytes(
+        blob_writer, blob_sharing, data.data(), data.size_in_bytes(), codec, type.size());
   }
   return write_blob_raw_data_with_endian(
-      blob_writer, blob_sharing, data.data(), data.size_in_bytes());
+      blob_writer, blob_sharing, data.data(), data.size_in_bytes(), codec, type.size());
 }
 
 [[nodiscard]] static bool read_blob_simple_gspan(const BlobReader &blob_reader,
@@ -0,0 +1,178 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_bake_items_serialize.hh"
+
+namespace blender::bke::bake::tests {
+
+using namespace blender::io::serialize;
+
+/** Keeps all written data in a single buffer in memory. */
+class MemoryBlobWriter : public BlobWriter {
+ public:
+  Vector<uint8_t> buffer;
+
+  BlobSlice write(const void *data, const int64_t size) override
+  {
+    const int64_t start = this->buffer.size();
+    this->buffer.extend(Span<uint8_t>(static_cast<const uint8_t *>(data), size));
+    return {"blob", {start, size}};
+  }
+};
+
+class MemoryBlobReader : public BlobReader {
+ private:
+  Span<uint8_t> buffer_;
+
+ public:
+  MemoryBlobReader(const Span<uint8_t> buffer) : buffer_(buffer) {}
+
+  bool read(const BlobSlice &slice, void *r_data) const override
+  {
+    if (slice.range.start() < 0 || slice.range.one_after_last() > buffer_.size()) {
+      return false;
+    }
+    memcpy(r_data, buffer_.slice(slice.range).data(), slice.range.size());
+    return true;
+  }
+};
+
+/** Decoded size of compressed chunks, rounded down to whole elements by the writer. */
+static constexpr int64_t chunk_size_in_bytes = 1 << 20;
+
+template<typename T>
+static void test_round_trip(const Span<T> data,
+                            const BlobCodec codec,
+                            const int64_t expected_chunks_num)
+{
+  MemoryBlobWriter writer;
+  BlobWriteSharing sharing;
+  const std::shared_ptr<DictionaryValue> io_data = sharing.write_deduplicated_compressed(
+      writer, data.data(), data.size_in_bytes(), codec, sizeof(T));
+
+  const std::optional<CompressedBlobSlice> compressed = CompressedBlobSlice::deserialize(
+      *io_data);
+  ASSERT_TRUE(compressed.has_value());
+  if (expected_chunks_num == 0) {
+    EXPECT_EQ(compressed->codec, BlobCodec::None);
+  }
+  else {
+    EXPECT_EQ(compressed->codec, codec);
+    EXPECT_EQ(compressed->chunk_sizes.size(), expected_chunks_num);
+    EXPECT_LT(compressed->slice.range.size(), data.size_in_bytes());
+  }
+
+  MemoryBlobReader reader(writer.buffer);
+  Array<T> result(data.size());
+  ASSERT_TRUE(read_compressed_blob(reader, *compressed, data.size_in_bytes(), result.data()));
+  EXPECT_EQ(result.as_span(), data);
+}
+
+template<typename T> static int64_t elements_per_chunk()
+{
+  return chunk_size_in_bytes / sizeof(T);
+}
+
+static Array<float3> create_float3_data(const int64_t size)
+{
+  Array<float3> data(size);
+  for (const int64_t i : data.index_range()) {
+    data[i] = float3(float(i % 100), float(i % 7) * 0.5f, -float(i % 13));
+  }
+  return data;
+}
+
+static Array<int> create_int_data(const int64_t size)
+{
+  Array<int> data(size);
+  for (const int64_t i : data.index_range()) {
+    data[i] = int(i / 3);
+  }
+  return data;
+}
+
+static Array<bool> create_bool_data(const int64_t size)
+{
+  Array<bool> data(size);
+  for (const int64_t i : data.index_range()) {
+    data[i] = (i % 5) < 2;
+  }
+  return data;
+}
+
+TEST(bake_compressed_blob, Float3RoundTrip)
+{
+  const int64_t chunk = elements_per_chunk<float3>();
+  test_round_trip<float3>(create_float3_data(10), BlobCodec::ZstdShuffle, 0);
+  test_round_trip<float3>(create_float3_data(chunk), BlobCodec::ZstdShuffle, 1);
+  test_round_trip<float3>(create_float3_data(chunk * 2 + 123), BlobCodec::ZstdShuffle, 3);
+}
+
+TEST(bake_compressed_blob, IntRoundTrip)
+{
+  const int64_t chunk = elements_per_chunk<int>();
+  test_round_trip<int>(create_int_data(63), BlobCodec::ZstdShuffle, 0);
+  test_round_trip<int>(create_int_data(chunk), BlobCodec::ZstdShuffle, 1);
+  test_round_trip<int>(create_int_data(chunk * 3 + 1), BlobCodec::ZstdShuffle, 4);
+}
+
+TEST(bake_compressed_blob, BoolRoundTrip)
+{
+  const int64_t chunk = elements_per_chunk<bool>();
+  test_round_trip<bool>(create_bool_data(255), BlobCodec::ZstdBits, 0);
+  test_round_trip<bool>(create_bool_data(chunk), BlobCodec::ZstdBits, 1);
+  test_round_trip<bool>(create_bool_data(chunk + 17), BlobCodec::ZstdBits, 2);
+}
+
+TEST(bake_compressed_blob, ReadLegacySlice)
+{
+  /* Data written before compression was added only stores the slice. */
+  const Array<int> data = create_int_data(1000);
+  MemoryBlobWriter writer;
+  const BlobSlice slice = writer.write(data.data(), data.as_span().size_in_bytes());
+  const std::shared_ptr<DictionaryValue> io_data = slice.serialize();
+
+  const std::optional<CompressedBlobSlice> compressed = CompressedBlobSlice::deserialize(
+      *io_data);
+  ASSERT_TRUE(compressed.has_value());
+  EXPECT_EQ(compressed->codec, BlobCodec::None);
+
+  MemoryBlobReader reader(writer.buffer);
+  Array<int> result(data.size());
+  ASSERT_TRUE(read_compressed_blob(
+      reader, *compressed, data.as_span().size_in_bytes(), result.data()));
+  EXPECT_EQ(result.as_span(), data.as_span());
+}
+
+TEST(bake_compressed_blob, RejectInvalidChunks)
+{
+  const Array<int> data = create_int_data(elements_per_chunk<int>() * 2);
+  MemoryBlobWriter writer;
+  BlobWriteSharing sharing;
+  const std::shared_ptr<DictionaryValue> io_data = sharing.write_deduplicated_compressed(
+      writer, data.data(), data.as_span().size_in_bytes(), BlobCodec::ZstdShuffle, sizeof(int));
+  std::optional<CompressedBlobSlice> compressed = CompressedBlobSlice::deserialize(*io_data);
+  ASSERT_TRUE(compressed.has_value());
+  ASSERT_EQ(compressed->chunk_sizes.size(), 2);
+
+  /* Chunk sizes that still add up to the slice size, but with a negative entry. */
+  CompressedBlobSlice negative = *compressed;
+  negative.chunk_sizes[0] = -compressed->chunk_sizes[1];
+  negative.chunk_sizes[1] = compressed->slice.range.size() - negative.chunk_sizes[0];
+  EXPECT_FALSE(CompressedBlobSlice::deserialize(*negative.serialize()).has_value());
+
+  CompressedBlobSlice partial_elements = *compressed;
+  partial_elements.chunk_size += 1;
+  EXPECT_FALSE(CompressedBlobSlice::deserialize(*partial_elements.serialize()).has_value());
+}
+
+}  // namespace blender::bke::bake::tests
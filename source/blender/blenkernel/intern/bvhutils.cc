@@ -16,6 +16,7 @@
 #include "BKE_bvhutils.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_mesh.hh"
+#include "BKE_pointcloud.hh"
 
 using blender::BitSpan;
 using blender::BitVector;
@@ -1176,26 +1177,45 @@ void BKE_bvhtree_from_pointcloud_get(const PointCloud &pointcloud,
                                      const blender::IndexMask &points_mask,
                                      BVHTreeFromPointCloud &r_data)
 {
+  using namespace blender;
+  const Span<float3> positions = pointcloud.positions();
+  r_data.coords = (const float(*)[3])positions.data();
+  r_data.nearest_callback = nullptr;
+
+  if (points_mask.size() == pointcloud.totpoint) {
+    /* Can use cache if all points are in the bvh tree. */
+    pointcloud.runtime->bvh_cache.ensure([&](BVHTreePtr &r_tree) {
+      int active_num = -1;
+      r_tree.reset(bvhtree_new_common(0.0f, 2, 6, pointcloud.totpoint, active_num));
+      if (!r_tree) {
+        return;
+      }
+      for (const int i : positions.index_range()) {
+        BLI_bvhtree_insert(r_tree.get(), i, positions[i], 1);
+      }
+      BLI_bvhtree_balance(r_tree.get());
+    });
+    r_data.tree = pointcloud.runtime->bvh_cache.data().get();
+    r_data.cached = true;
+    return;
+  }
+
   int active_num = -1;
   BVHTree *tree = bvhtree_new_common(0.0f, 2, 6, points_mask.size(), active_num);
   r_data.tree = tree;
+  r_data.cached = false;
   if (!tree) {
     return;
   }
 
-  const Span<float3> positions = pointcloud.positions();
   points_mask.foreach_index([&](const int i) { BLI_bvhtree_insert(tree, i, positions[i], 1); });
 
   BLI_bvhtree_balance(tree);
-
-  r_data.coords = (const float(*)[3])positions.data();
-  r_data.tree = tree;
-  r_data.nearest_callback = nullptr;
 }
 
 void free_bvhtree_from_pointcloud(BVHTreeFromPointCloud *data)
 {
-  if (data->tree) {
+  if (data->tree && !data->cached) {
     BLI_bvhtree_free(data->tree);
   }
   memset(data, 0, sizeof(*data));
@@ -12,6 +12,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
+#include <mutex>
 
 #include "MEM_guardedalloc.h"
 
@@ -173,6 +174,7 @@ Mesh *BKE_mesh_remesh_quadriflow(const Mesh *mesh,
 static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
                                                              const float voxel_size)
 {
+  using namespace blender;
   const Span<float3> positions = mesh->vert_positions();
   const Span<int> corner_verts = mesh->corner_verts();
   const Span<int3> corner_tris = mesh->corner_tris();
@@ -180,16 +182,20 @@ static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
   std::vector<openvdb::Vec3s> points(mesh->verts_num);
   std::vector<openvdb::Vec3I> triangles(corner_tris.size());
 
-  for (const int i : IndexRange(mesh->verts_num)) {
-    const float3 &co = positions[i];
-    points[i] = openvdb::Vec3s(co.x, co.y, co.z);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const float3 &co = positions[i];
+      points[i] = openvdb::Vec3s(co.x, co.y, co.z);
+    }
+  });
 
-  for (const int i : IndexRange(corner_tris.size())) {
-    const int3 &tri = corner_tris[i];
-    triangles[i] = openvdb::Vec3I(
-        corner_verts[tri[0]], corner_verts[tri[1]], corner_verts[tri[2]]);
-  }
+  threading::parallel_for(corner_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int3 &tri = corner_tris[i];
+      triangles[i] = openvdb::Vec3I(
+          corner_verts[tri[0]], corner_verts[tri[1]], corner_verts[tri[2]]);
+    }
+  });
 
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
       voxel_size);
@@ -199,7 +205,50 @@ static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
   return grid;
 }
 
-static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set_grid,
+namespace blender::bke {
+
+/**
+ * The level set of a mesh, stored in #MeshRuntime::remesh_voxel_level_set_cache. Creating the
+ * level set is one of the two expensive steps of remeshing, and it only depends on the positions,
+ * the topology and the voxel size. Only the grid for the last used voxel size is kept.
+ */
+struct RemeshVoxelLevelSet {
+  /** Protects the grid when the cache is shared between meshes that are remeshed in parallel. */
+  std::mutex mutex;
+  float voxel_size = 0.0f;
+  openvdb::FloatGrid::ConstPtr grid;
+};
+
+}  // namespace blender::bke
+
+static openvdb::FloatGrid::ConstPtr remesh_voxel_level_set_ensure(const Mesh *mesh,
+                                                                  const float voxel_size)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  SharedCache<std::shared_ptr<RemeshVoxelLevelSet>> &cache =
+      mesh->runtime->remesh_voxel_level_set_cache;
+  cache.ensure([&](std::shared_ptr<RemeshVoxelLevelSet> &r_data) {
+    r_data = std::make_shared<RemeshVoxelLevelSet>();
+  });
+  RemeshVoxelLevelSet &level_set = *cache.data();
+  {
+    std::lock_guard lock{level_set.mutex};
+    if (level_set.grid && level_set.voxel_size == voxel_size) {
+      return level_set.grid;
+    }
+  }
+
+  /* Create the grid without holding the lock, since OpenVDB uses multiple threads for it. */
+  openvdb::FloatGrid::ConstPtr grid = remesh_voxel_level_set_create(mesh, voxel_size);
+
+  std::lock_guard lock{level_set.mutex};
+  level_set.voxel_size = voxel_size;
+  level_set.grid = grid;
+  return grid;
+}
+
+static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::ConstPtr level_set_grid,
                                          const float isovalue,
                                          const float adaptivity,
                                          const bool relax_disoriented_triangles)
@@ -225,24 +274,30 @@ static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set
         3, triangle_loop_start, face_offsets.drop_front(quads.size()));
   }
 
-  for (const int i : vert_positions.index_range()) {
-    vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
-  }
+  threading::parallel_for(vert_positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      vert_positions[i] = float3(vertices[i].x(), vertices[i].y(), vertices[i].z());
+    }
+  });
 
-  for (const int i : IndexRange(quads.size())) {
-    const int loopstart = i * 4;
-    mesh_corner_verts[loopstart] = quads[i][0];
-    mesh_corner_verts[loopstart + 1] = quads[i][3];
-    mesh_corner_verts[loopstart + 2] = quads[i][2];
-    mesh_corner_verts[loopstart + 3] = quads[i][1];
-  }
+  threading::parallel_for(IndexRange(quads.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int loopstart = i * 4;
+      mesh_corner_verts[loopstart] = quads[i][0];
+      mesh_corner_verts[loopstart + 1] = quads[i][3];
+      mesh_corner_verts[loopstart + 2] = quads[i][2];
+      mesh_corner_verts[loopstart + 3] = quads[i][1];
+    }
+  });
 
-  for (const int i : IndexRange(tris.size())) {
-    const int loopstart = triangle_loop_start + i * 3;
-    mesh_corner_verts[loopstart] = tris[i][2];
-    mesh_corner_verts[loopstart + 1] = tris[i][1];
-    mesh_corner_verts[loopstart + 2] = tris[i][0];
-  }
+  threading::parallel_for(IndexRange(tris.size()), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int loopstart = triangle_loop_start + i * 3;
+      mesh_corner_verts[loopstart] = tris[i][2];
+      mesh_corner_verts[loopstart + 1] = tris[i][1];
+      mesh_corner_verts[loopstart + 2] = tris[i][0];
+    }
+  });
 
   mesh_calc_edges(*mesh, false, false);
 
@@ -256,7 +311,7 @@ Mesh *BKE_mesh_remesh_voxel(const Mesh *mesh,
                             const float isovalue)
 {
 #ifdef WITH_OPENVDB
-  openvdb::FloatGrid::Ptr level_set = remesh_voxel_level_set_create(mesh, voxel_size);
+  openvdb::FloatGrid::ConstPtr level_set = remesh_voxel_level_set_ensure(mesh, voxel_size);
   Mesh *result = remesh_voxel_volume_to_mesh(level_set, isovalue, adaptivity, false);
   BKE_mesh_copy_parameters(result, mesh);
   return result;
@@ -328,6 +328,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->corner_tris_cache.data.tag_dirty();
   mesh->runtime->corner_tri_faces_cache.tag_dirty();
   mesh->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  mesh->runtime->remesh_voxel_level_set_cache.tag_dirty();
   mesh->runtime->subsurf_face_dot_tags.clear_and_shrink();
   mesh->runtime->subsurf_optimal_display_edges.clear_and_shrink();
   mesh->flag &= ~ME_NO_OVERLAPPING_TOPOLOGY;
@@ -396,6 +397,7 @@ void Mesh::tag_positions_changed_no_normals()
   this->runtime->corner_tris_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
+  this->runtime->remesh_voxel_level_set_cache.tag_dirty();
 }
 
 void Mesh::tag_positions_changed_uniformly()
@@ -403,6 +405,7 @@ void Mesh::tag_positions_changed_uniformly()
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
   free_bvh_cache(*this->runtime);
   this->runtime->bounds_cache.tag_dirty();
+  this->runtime->remesh_voxel_level_set_cache.tag_dirty();
 }
 
 void Mesh::tag_topology_changed()
@@ -65,14 +65,63 @@ static Bounds<float3> merge_bounds(const Bounds<float3> &a, const Bounds<float3>
   return bounds::merge(a, b);
 }
 
+/**
+ * Partition large spans with multiple threads: count the matching elements per chunk, and then
+ * scatter all elements to their final position. Unlike #std::partition the relative order of the
+ * elements on each side is kept.
+ */
+template<typename Predicate>
+static int partition_parallel(MutableSpan<int> data, const Predicate &predicate)
+{
+  constexpr int64_t chunk_size = 8192;
+  const int64_t chunks_num = divide_ceil_ul(data.size(), chunk_size);
+  const auto chunk_range = [&](const int64_t chunk) {
+    return IndexRange::from_begin_size(chunk * chunk_size,
+                                       std::min(chunk_size, data.size() - chunk * chunk_size));
+  };
+
+  Array<int> true_offsets(chunks_num + 1);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const Span<int> chunk_data = data.slice(chunk_range(chunk));
+      true_offsets[chunk] = std::count_if(chunk_data.begin(), chunk_data.end(), predicate);
+    }
+  });
+  const int true_num = offset_indices::accumulate_counts_to_offsets(true_offsets).total_size();
+
+  Array<int> result(data.size(), NoInitialization());
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const IndexRange chunk_indices = chunk_range(chunk);
+      int true_index = true_offsets[chunk];
+      int false_index = true_num + chunk_indices.start() - true_offsets[chunk];
+      for (const int value : data.slice(chunk_indices)) {
+        if (predicate(value)) {
+          result[true_index++] = value;
+        }
+        else {
+          result[false_index++] = value;
+        }
+      }
+    }
+  });
+  array_utils::copy(result.as_span(), data);
+  return true_num;
+}
+
+/** Below this size, the overhead of partitioning in parallel isn't worth it. */
+static constexpr int64_t partition_parallel_threshold = 65536;
+
 static int partition_along_axis(const Span<float3> face_centers,
                                 MutableSpan<int> faces,
                                 const int axis,
                                 const float middle)
 {
-  const int *split = std::partition(faces.begin(), faces.end(), [&](const int face) {
-    return face_centers[face][axis] >= middle;
-  });
+  const auto predicate = [&](const int face) { return face_centers[face][axis] >= middle; };
+  if (faces.size() >= partition_parallel_threshold) {
+    return partition_parallel(faces, predicate);
+  }
+  const int *split = std::partition(faces.begin(), faces.end(), predicate);
   return split - faces.begin();
 }
 
@@ -144,6 +193,25 @@ static bool leaf_needs_material_split(const Span<int> faces, const Span<int> mat
   return false;
 }
 
+/**
+ * A part of the tree that is small enough to be built on a single thread. Subtrees are built
+ * independently in parallel and appended to the final node array afterwards.
+ */
+struct MeshSubtree {
+  /** The index of the root of the subtree in the final node array. */
+  int node_index;
+  int depth;
+  MutableSpan<int> faces;
+  Vector<MeshNode> nodes;
+};
+
+/** Roughly the number of faces in a subtree, leaving enough subtrees for parallelism. */
+static constexpr int64_t subtree_faces_num = 131072;
+
+/**
+ * \param r_subtrees: When provided, large enough nodes aren't built directly, but added to this
+ * array to be built later with #build_subtrees_mesh.
+ */
 static void build_nodes_recursive_mesh(const Span<int> material_indices,
                                        const int leaf_limit,
                                        const int node_index,
@@ -151,8 +219,14 @@ static void build_nodes_recursive_mesh(const Span<int> material_indices,
                                        const Span<float3> face_centers,
                                        const int depth,
                                        MutableSpan<int> faces,
-                                       Vector<MeshNode> &nodes)
+                                       Vector<MeshNode> &nodes,
+                                       Vector<MeshSubtree> *r_subtrees)
 {
+  if (r_subtrees && faces.size() <= subtree_faces_num) {
+    r_subtrees->append({node_index, depth, faces, {}});
+    return;
+  }
+
   /* Decide whether this is a leaf or not */
   const bool below_leaf_limit = faces.size() <= leaf_limit || depth >= STACK_FIXED_DEPTH - 1;
   if (below_leaf_limit) {
@@ -206,7 +280,8 @@ static void build_nodes_recursive_mesh(const Span<int> material_indices,
                              face_centers,
                              depth + 1,
                              faces.take_front(split),
-                             nodes);
+                             nodes,
+                             r_subtrees);
   build_nodes_recursive_mesh(material_indices,
                              leaf_limit,
                              nodes[node_index].children_offset_ + 1,
@@ -214,7 +289,44 @@ static void build_nodes_recursive_mesh(const Span<int> material_indices,
                              face_centers,
                              depth + 1,
                              faces.drop_front(split),
-                             nodes);
+                             nodes,
+                             r_subtrees);
+}
+
+static void build_subtrees_mesh(const Span<int> material_indices,
+                                const int leaf_limit,
+                                const Span<float3> face_centers,
+                                MutableSpan<MeshSubtree> subtrees,
+                                Vector<MeshNode> &nodes)
+{
+  threading::parallel_for(subtrees.index_range(), 1, [&](const IndexRange range) {
+    for (MeshSubtree &subtree : subtrees.slice(range)) {
+      subtree.nodes.resize(1);
+      build_nodes_recursive_mesh(material_indices,
+                                 leaf_limit,
+                                 0,
+                                 std::nullopt,
+                                 face_centers,
+                                 subtree.depth,
+                                 subtree.faces,
+                                 subtree.nodes,
+                                 nullptr);
+    }
+  });
+
+  /* The root of every subtree replaces its placeholder node, the other nodes are appended. */
+  for (MeshSubtree &subtree : subtrees) {
+    const int offset = nodes.size() - 1;
+    for (MeshNode &node : subtree.nodes) {
+      if (!(node.flag_ & PBVH_Leaf)) {
+        node.children_offset_ += offset;
+      }
+    }
+    nodes[subtree.node_index] = std::move(subtree.nodes.first());
+    for (MeshNode &node : subtree.nodes.as_mutable_span().drop_front(1)) {
+      nodes.append(std::move(node));
+    }
+  }
 }
 
 inline Bounds<float3> calc_face_bounds(const Span<float3> vert_positions,
@@ -273,8 +385,17 @@ std::unique_ptr<Tree> build_mesh(const Mesh &mesh)
 #ifdef DEBUG_BUILD_TIME
     SCOPED_TIMER_AVERAGED("build_nodes_recursive_mesh");
 #endif
-    build_nodes_recursive_mesh(
-        material_index, leaf_limit, 0, bounds, face_centers, 0, pbvh->prim_indices_, nodes);
+    Vector<MeshSubtree> subtrees;
+    build_nodes_recursive_mesh(material_index,
+                               leaf_limit,
+                               0,
+                               bounds,
+                               face_centers,
+                               0,
+                               pbvh->prim_indices_,
+                               nodes,
+                               &subtrees);
+    build_subtrees_mesh(material_index, leaf_limit, face_centers, subtrees, nodes);
   }
 
   build_mesh_leaf_nodes(mesh.verts_num, faces, corner_verts, nodes);
@@ -16,6 +16,7 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -969,54 +970,89 @@ static void short_edge_queue_edge_add(EdgeQueueContext *eq_ctx, BMEdge *e)
   }
 }
 
-static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+/** Return true if the face faces the view (when enabled) and intersects the brush range. */
+static bool edge_queue_face_in_range(const EdgeQueue *q, BMFace *f)
 {
 #ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
+  if (q->use_view_normal) {
+    if (dot_v3v3(f->no, q->view_normal) < 0.0f) {
+      return false;
     }
   }
 #endif
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    /* Check each edge of the face. */
-    BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
-    BMLoop *l_iter = l_first;
-    do {
+  return q->edge_queue_tri_in_range(q, f);
+}
+
+static void long_edge_queue_face_add_edges(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  /* Check each edge of the face. */
+  BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
+  BMLoop *l_iter = l_first;
+  do {
 #ifdef USE_EDGEQUEUE_EVEN_SUBDIV
-      const float len_sq = BM_edge_calc_length_squared(l_iter->e);
-      if (len_sq > eq_ctx->q->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
-      }
+    const float len_sq = BM_edge_calc_length_squared(l_iter->e);
+    if (len_sq > eq_ctx->q->limit_len_squared) {
+      long_edge_queue_edge_add_recursive(
+          eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->q->limit_len);
+    }
 #else
-      long_edge_queue_edge_add(eq_ctx, l_iter->e);
+    long_edge_queue_edge_add(eq_ctx, l_iter->e);
 #endif
-    } while ((l_iter = l_iter->next) != l_first);
-  }
+  } while ((l_iter = l_iter->next) != l_first);
 }
 
-static void short_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
+static void long_edge_queue_face_add(EdgeQueueContext *eq_ctx, BMFace *f)
 {
-#ifdef USE_EDGEQUEUE_FRONTFACE
-  if (eq_ctx->q->use_view_normal) {
-    if (dot_v3v3(f->no, eq_ctx->q->view_normal) < 0.0f) {
-      return;
-    }
+  if (edge_queue_face_in_range(eq_ctx->q, f)) {
+    long_edge_queue_face_add_edges(eq_ctx, f);
   }
-#endif
+}
 
-  if (eq_ctx->q->edge_queue_tri_in_range(eq_ctx->q, f)) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
+static void short_edge_queue_face_add_edges(EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  BMLoop *l_iter;
+  BMLoop *l_first;
 
-    /* Check each edge of the face. */
-    l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-    do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
-    } while ((l_iter = l_iter->next) != l_first);
+  /* Check each edge of the face. */
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    short_edge_queue_edge_add(eq_ctx, l_iter->e);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+/**
+ * Find the faces of the leaf nodes marked for topology update that are in range of the brush.
+ *
+ * The range tests only read the mesh and are the most expensive part of building the edge queues,
+ * so nodes are tested in parallel. The queue itself is filled afterwards on a single thread since
+ * edge tags, the heap and the vertex pair pool are shared. Faces are returned grouped by node in
+ * node order so the queue contents don't depend on the scheduling.
+ */
+static Array<Vector<BMFace *>> edge_queue_faces_in_range(const EdgeQueue *q,
+                                                         const Span<BMeshNode> nodes)
+{
+  Vector<int> node_indices;
+  for (const int i : nodes.index_range()) {
+    const BMeshNode &node = nodes[i];
+    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
+        !(node.flag_ & PBVH_FullyHidden))
+    {
+      node_indices.append(i);
+    }
   }
+
+  Array<Vector<BMFace *>> faces_by_node(node_indices.size());
+  threading::parallel_for(node_indices.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (BMFace *f : nodes[node_indices[i]].bm_faces_) {
+        if (edge_queue_face_in_range(q, f)) {
+          faces_by_node[i].append(f);
+        }
+      }
+    }
+  });
+  return faces_by_node;
 }
 
 /**
@@ -1066,14 +1102,9 @@ static void long_edge_queue_create(EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
+  for (const Vector<BMFace *> &faces : edge_queue_faces_in_range(eq_ctx->q, nodes)) {
+    for (BMFace *f : faces) {
+      long_edge_queue_face_add_edges(eq_ctx, f);
     }
   }
 }
@@ -1121,14 +1152,9 @@ static void short_edge_queue_create(EdgeQueueContext *eq_ctx,
     eq_ctx->q->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & PBVH_Leaf) && (node.flag_ & PBVH_UpdateTopology) &&
-        !(node.flag_ & PBVH_FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
+  for (const Vector<BMFace *> &faces : edge_queue_faces_in_range(eq_ctx->q, nodes)) {
+    for (BMFace *f : faces) {
+      short_edge_queue_face_add_edges(eq_ctx, f);
     }
   }
 }
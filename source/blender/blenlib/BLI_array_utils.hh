@@ -308,4 +308,13 @@ bool indexed_data_equal(const Span<T> all_values, const Span<int> indices, const
 
 bool indices_are_range(Span<int> indices, IndexRange range);
 
+/**
+ * Reorder the bytes of \a src so that the bytes with the same significance of all elements are
+ * stored next to each other. This generally makes numeric data much more compressible.
+ * \param element_size: Size of an element in bytes. The size of \a src must be a multiple of it.
+ */
+void shuffle_bytes(Span<uint8_t> src, int64_t element_size, MutableSpan<uint8_t> dst);
+/** Reverse of #shuffle_bytes. */
+void unshuffle_bytes(Span<uint8_t> src, int64_t element_size, MutableSpan<uint8_t> dst);
+
 }  // namespace blender::array_utils
@@ -307,11 +307,22 @@ extern const float bvhtree_kdop_axes[13][3];
 
 #ifdef __cplusplus
 
+#  include <memory>
+
 #  include "BLI_function_ref.hh"
 #  include "BLI_math_vector.hh"
 
 namespace blender {
 
+struct BVHTreeDeleter {
+  void operator()(BVHTree *tree)
+  {
+    BLI_bvhtree_free(tree);
+  }
+};
+
+using BVHTreePtr = std::unique_ptr<BVHTree, BVHTreeDeleter>;
+
 using BVHTree_RayCastCallback_CPP =
     FunctionRef<void(int index, const BVHTreeRay &ray, BVHTreeRayHit &hit)>;
 
@@ -6,6 +6,7 @@
 
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -133,6 +134,21 @@ float3 perlin_float3_fractal_distorted(float4 position,
                                        int type,
                                        bool normalize);
 
+/* Batched versions of the functions above for many 3D positions. They use SIMD instructions when
+ * available and give the same results up to floating point precision. */
+
+void perlin_signed(Span<float3> positions, MutableSpan<float> r_values);
+void perlin_fractal_distorted(Span<float3> positions,
+                              float detail,
+                              float roughness,
+                              float lacunarity,
+                              float offset,
+                              float gain,
+                              float distortion,
+                              int type,
+                              bool normalize,
+                              MutableSpan<float> r_values);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
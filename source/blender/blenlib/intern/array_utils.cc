@@ -224,4 +224,30 @@ bool indices_are_range(Span<int> indices, IndexRange range)
       std::logical_and<bool>());
 }
 
+void shuffle_bytes(const Span<uint8_t> src, const int64_t element_size, MutableSpan<uint8_t> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  BLI_assert(src.size() % element_size == 0);
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t byte : IndexRange(element_size)) {
+    uint8_t *dst_bytes = dst.data() + byte * elements_num;
+    for (const int64_t i : IndexRange(elements_num)) {
+      dst_bytes[i] = src[i * element_size + byte];
+    }
+  }
+}
+
+void unshuffle_bytes(const Span<uint8_t> src, const int64_t element_size, MutableSpan<uint8_t> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  BLI_assert(src.size() % element_size == 0);
+  const int64_t elements_num = src.size() / element_size;
+  for (const int64_t byte : IndexRange(element_size)) {
+    const uint8_t *src_bytes = src.data() + byte * elements_num;
+    for (const int64_t i : IndexRange(elements_num)) {
+      dst[i * element_size + byte] = src_bytes[i];
+    }
+  }
+}
+
 }  // namespace blender::array_utils
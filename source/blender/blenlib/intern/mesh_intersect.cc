@@ -1123,6 +1123,40 @@ static int filter_plane_side(const double3 &p,
   return 0;
 }
 
+/**
+ * The index of the expression computed in #filter_tti_above: `dot(ad, cross(ba, ca))`, where
+ * `ad`, `ba` and `ca` are differences of input coordinates (index 2).
+ */
+constexpr int index_tti_above = 11;
+
+/**
+ * Return the approximate sign of `dot(d - a, cross(b - a, c - a))`, with the same convention as
+ * #filter_plane_side: 0 means that exact arithmetic has to be used to get the answer.
+ */
+static int filter_tti_above(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  const double3 ba = b - a;
+  const double3 ca = c - a;
+  const double3 ad = d - a;
+  const double det = math::dot(ad, math::cross(ba, ca));
+  if (det == 0.0) {
+    return 0;
+  }
+  const double3 abs_a = math::abs(a);
+  const double3 abs_ba = math::abs(b) + abs_a;
+  const double3 abs_ca = math::abs(c) + abs_a;
+  const double3 abs_ad = math::abs(d) + abs_a;
+  const double3 abs_n(abs_ba.y * abs_ca.z + abs_ba.z * abs_ca.y,
+                      abs_ba.z * abs_ca.x + abs_ba.x * abs_ca.z,
+                      abs_ba.x * abs_ca.y + abs_ba.y * abs_ca.x);
+  const double supremum = math::dot(abs_ad, abs_n);
+  const double err_bound = supremum * index_tti_above * DBL_EPSILON;
+  if (fabs(det) > err_bound) {
+    return det > 0 ? 1 : -1;
+  }
+  return 0;
+}
+
 /*
  * #intersect_tri_tri and helper functions.
  * This code uses the algorithm of Guigue and Devillers, as described
@@ -1153,25 +1187,33 @@ static inline mpq3 tti_interp(
 }
 
 /**
- * Return +1, 0, -1 as a + ad is above, on, or below the oriented plane containing a, b, c in CCW
- * order. This is the same as -oriented(a, b, c, a + ad), but uses fewer arithmetic operations.
- * TODO: change arguments to `const Vert *` and use floating filters.
- * The ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
+ * Return +1, 0, -1 as d is above, on, or below the oriented plane containing a, b, c in CCW
+ * order. This is the same as -oriented(a, b, c, d), but uses fewer arithmetic operations.
+ * The answer is computed with floating point filters first; exact arithmetic is only used when
+ * the filter cannot decide.
+ * The ad, ba, ca, n, and dotbuf arguments are used as temporaries; declaring them
  * in the caller can avoid many allocations and frees of mpq3 and mpq_class structures.
  */
-static inline int tti_above(const mpq3 &a,
-                            const mpq3 &b,
-                            const mpq3 &c,
-                            const mpq3 &ad,
+static inline int tti_above(const Vert *a,
+                            const Vert *b,
+                            const Vert *c,
+                            const Vert *d,
+                            mpq3 &ad,
                             mpq3 &ba,
                             mpq3 &ca,
                             mpq3 &n,
                             mpq3 &dotbuf)
 {
-  ba = b;
-  ba -= a;
-  ca = c;
-  ca -= a;
+  const int filter_side = filter_tti_above(a->co, b->co, c->co, d->co);
+  if (filter_side != 0) {
+    return filter_side;
+  }
+  ad = d->co_exact;
+  ad -= a->co_exact;
+  ba = b->co_exact;
+  ba -= a->co_exact;
+  ca = c->co_exact;
+  ca -= a->co_exact;
 
   n.x = ba.y * ca.z - ba.z * ca.y;
   n.y = ba.z * ca.x - ba.x * ca.z;
@@ -1193,16 +1235,22 @@ static inline int tti_above(const mpq3 &a,
  *   of the plane and at least one of q1 and r1 are off the plane.
  * Similarly for p2, q2, r2 with respect to the first triangle's plane.
  */
-static ITT_value itt_canon2(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon2(const Vert *vp1,
+                            const Vert *vq1,
+                            const Vert *vr1,
+                            const Vert *vp2,
+                            const Vert *vq2,
+                            const Vert *vr2,
                             const mpq3 &n1,
                             const mpq3 &n2)
 {
   constexpr int dbg_level = 0;
+  const mpq3 &p1 = vp1->co_exact;
+  const mpq3 &q1 = vq1->co_exact;
+  const mpq3 &r1 = vr1->co_exact;
+  const mpq3 &p2 = vp2->co_exact;
+  const mpq3 &q2 = vq2->co_exact;
+  const mpq3 &r2 = vr2->co_exact;
   if (dbg_level > 0) {
     std::cout << "\ntri_tri_intersect_canon:\n";
     std::cout << "p1=" << p1 << " q1=" << q1 << " r1=" << r1 << "\n";
@@ -1218,17 +1266,16 @@ static ITT_value itt_canon2(const mpq3 &p1,
     std::cout << "n1=(" << n1[0].get_d() << "," << n1[1].get_d() << "," << n1[2].get_d() << ")\n";
     std::cout << "n2=(" << n2[0].get_d() << "," << n2[1].get_d() << "," << n2[2].get_d() << ")\n";
   }
-  mpq3 p1p2 = p2 - p1;
   mpq3 intersect_1;
   mpq3 intersect_2;
-  mpq3 buf[4];
+  mpq3 buf[5];
   bool no_overlap = false;
   /* Top test in classification tree. */
-  if (tti_above(p1, q1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+  if (tti_above(vp1, vq1, vr2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) > 0) {
     /* Middle right test in classification tree. */
-    if (tti_above(p1, r1, r2, p1p2, buf[0], buf[1], buf[2], buf[3]) <= 0) {
+    if (tti_above(vp1, vr1, vr2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) <= 0) {
       /* Bottom right test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) > 0) {
+      if (tti_above(vp1, vr1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) > 0) {
         /* Overlap is [k [i l] j]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i l] j]\n";
@@ -1257,7 +1304,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
   }
   else {
     /* Middle left test in classification tree. */
-    if (tti_above(p1, q1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) < 0) {
+    if (tti_above(vp1, vq1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) < 0) {
       /* No overlap: [i j] [k l]. */
       if (dbg_level > 0) {
         std::cout << "no overlap: [i j] [k l]\n";
@@ -1266,7 +1313,7 @@ static ITT_value itt_canon2(const mpq3 &p1,
     }
     else {
       /* Bottom left test in classification tree. */
-      if (tti_above(p1, r1, q2, p1p2, buf[0], buf[1], buf[2], buf[3]) >= 0) {
+      if (tti_above(vp1, vr1, vq2, vp2, buf[0], buf[1], buf[2], buf[3], buf[4]) >= 0) {
         /* Overlap is [k [i j] l]. */
         if (dbg_level > 0) {
           std::cout << "overlap [k [i j] l]\n";
@@ -1303,12 +1350,12 @@ static ITT_value itt_canon2(const mpq3 &p1,
 
 /* Helper function for intersect_tri_tri. Arguments have been canonicalized for triangle 1. */
 
-static ITT_value itt_canon1(const mpq3 &p1,
-                            const mpq3 &q1,
-                            const mpq3 &r1,
-                            const mpq3 &p2,
-                            const mpq3 &q2,
-                            const mpq3 &r2,
+static ITT_value itt_canon1(const Vert *p1,
+                            const Vert *q1,
+                            const Vert *r1,
+                            const Vert *p2,
+                            const Vert *q2,
+                            const Vert *r2,
                             const mpq3 &n1,
                             const mpq3 &n2,
                             int sp2,
@@ -1510,49 +1557,49 @@ static ITT_value intersect_tri_tri(const IMesh &tm, int t1, int t2)
   ITT_value ans;
   if (sp1 > 0) {
     if (sq1 > 0) {
-      ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else if (sr1 > 0) {
-      ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
   }
   else if (sp1 < 0) {
     if (sq1 < 0) {
-      ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else if (sr1 < 0) {
-      ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+      ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
     }
     else {
-      ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+      ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
     }
   }
   else {
     if (sq1 < 0) {
       if (sr1 >= 0) {
-        ans = itt_canon1(q1, r1, p1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(p1, q1, r1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else if (sq1 > 0) {
       if (sr1 > 0) {
-        ans = itt_canon1(p1, q1, r1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vp1, vq1, vr1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
-        ans = itt_canon1(q1, r1, p1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vq1, vr1, vp1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
     }
     else {
       if (sr1 > 0) {
-        ans = itt_canon1(r1, p1, q1, p2, q2, r2, n1, n2, sp2, sq2, sr2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vq2, vr2, n1, n2, sp2, sq2, sr2);
       }
       else if (sr1 < 0) {
-        ans = itt_canon1(r1, p1, q1, p2, r2, q2, n1, n2, sp2, sr2, sq2);
+        ans = itt_canon1(vr1, vp1, vq1, vp2, vr2, vq2, n1, n2, sp2, sr2, sq2);
       }
       else {
         if (dbg_level > 0) {
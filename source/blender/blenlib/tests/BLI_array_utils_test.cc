@@ -291,3 +291,26 @@ TEST(array_utils, FindAllRanges5)
   const std::array data_cmp = {IndexRange(0, 1), IndexRange(3, 2), IndexRange(6, 1)};
   find_all_ranges_test(data, data_cmp);
 }
+
+TEST(array_utils, ShuffleBytes)
+{
+  using namespace blender;
+  const std::array<uint8_t, 12> data = {0, 1, 2, 3, 10, 11, 12, 13, 20, 21, 22, 23};
+  const std::array<uint8_t, 12> expected = {0, 10, 20, 1, 11, 21, 2, 12, 22, 3, 13, 23};
+  std::array<uint8_t, 12> shuffled;
+  array_utils::shuffle_bytes(data, 4, shuffled);
+  EXPECT_EQ(Span(shuffled), Span(expected));
+
+  std::array<uint8_t, 12> unshuffled;
+  array_utils::unshuffle_bytes(shuffled, 4, unshuffled);
+  EXPECT_EQ(Span(unshuffled), Span(data));
+}
+
+TEST(array_utils, ShuffleBytesSingleByte)
+{
+  using namespace blender;
+  const std::array<uint8_t, 5> data = {5, 4, 3, 2, 1};
+  std::array<uint8_t, 5> shuffled;
+  array_utils::shuffle_bytes(data, 1, shuffled);
+  EXPECT_EQ(Span(shuffled), Span(data));
+}
@@ -15,8 +15,12 @@
 #include "BLI_math_mpq.hh"
 #include "BLI_math_vector_mpq_types.hh"
 #include "BLI_mesh_boolean.hh"
+#include "BLI_task.h"
+#include "BLI_time.h"
 #include "BLI_vector.hh"
 
+#define DO_PERF_TESTS 0
+
 #ifdef WITH_GMP
 namespace blender::meshintersect::tests {
 
@@ -957,5 +961,99 @@ TEST(boolean_polymesh, CubePlane)
   }
 }
 
+#  if DO_PERF_TESTS
+
+/**
+ * Add the quads of a closed box with `subdivs` x `subdivs` quads on each side. The box is rotated
+ * by `rot_deg` degrees around the z and x axes, so that most coordinates are not exact.
+ */
+static void fill_box_data(const int subdivs,
+                          const double3 &center,
+                          const double size,
+                          const double rot_deg,
+                          Vector<Face *> &faces,
+                          IMeshArena &arena)
+{
+  const double rot = rot_deg * M_PI / 180.0;
+  const double cos_rot = cos(rot);
+  const double sin_rot = sin(rot);
+  Array<int> eid = {0, 0, 0, 0}; /* Don't care about edge ids. */
+  /* Vertices are computed from their lattice position only, so that shared vertices of adjacent
+   * sides get the same coordinates and are merged by the arena. */
+  auto lattice_vert = [&](const int3 &lattice) {
+    const double3 p = double3(lattice) * (size / subdivs) - double3(size / 2.0);
+    const double3 p_z(p.x * cos_rot - p.y * sin_rot, p.x * sin_rot + p.y * cos_rot, p.z);
+    const double3 p_x(p_z.x, p_z.y * cos_rot - p_z.z * sin_rot, p_z.y * sin_rot + p_z.z * cos_rot);
+    const double3 co = p_x + center;
+    return arena.add_or_find_vert(mpq3(co.x, co.y, co.z), arena.tot_allocated_verts());
+  };
+  for (const int axis : IndexRange(3)) {
+    const int axis_u = (axis + 1) % 3;
+    const int axis_v = (axis + 2) % 3;
+    for (const int side : {0, subdivs}) {
+      for (const int u : IndexRange(subdivs)) {
+        for (const int v : IndexRange(subdivs)) {
+          std::array<const Vert *, 4> quad;
+          const int2 corners[4] = {{u, v}, {u + 1, v}, {u + 1, v + 1}, {u, v + 1}};
+          for (const int i : IndexRange(4)) {
+            int3 lattice;
+            lattice[axis] = side;
+            lattice[axis_u] = corners[i].x;
+            lattice[axis_v] = corners[i].y;
+            quad[i] = lattice_vert(lattice);
+          }
+          if (side == 0) {
+            /* Keep the normals pointing outwards. */
+            std::reverse(quad.begin(), quad.end());
+          }
+          faces.append(arena.add_face(quad, faces.size(), eid));
+        }
+      }
+    }
+  }
+}
+
+static void boxbox_test(const int subdivs, const BoolOpType op)
+{
+  BLI_task_scheduler_init(); /* Without this, no parallelism. */
+  double time_start = BLI_time_now_seconds();
+  IMeshArena arena;
+  Vector<Face *> faces;
+  fill_box_data(subdivs, double3(0.0), 2.0, 0.0, faces, arena);
+  const int box_faces_num = faces.size();
+  fill_box_data(subdivs, double3(0.5, 0.3, 0.2), 2.0, 10.0, faces, arena);
+  IMesh mesh(faces);
+  double time_create = BLI_time_now_seconds();
+  IMesh out = boolean_mesh(
+      mesh,
+      op,
+      2,
+      [box_faces_num](int f) { return f < box_faces_num ? 0 : 1; },
+      false,
+      false,
+      nullptr,
+      &arena);
+  double time_boolean = BLI_time_now_seconds();
+  std::cout << "Create time: " << time_create - time_start << "\n";
+  std::cout << "Boolean time: " << time_boolean - time_create << "\n";
+  std::cout << "Total time: " << time_boolean - time_start << "\n";
+  if (DO_OBJ) {
+    write_obj_mesh(out, "boxbox");
+  }
+  BLI_task_scheduler_exit();
+}
+
+TEST(boolean_perf, BoxBoxUnion)
+{
+  boxbox_test(64, BoolOpType::Union);
+}
+
+TEST(boolean_perf, BoxBoxDifference)
+{
+  boxbox_test(64, BoolOpType::Difference);
+}
+
+#  endif
+
 }  // namespace blender::meshintersect::tests
 #endif
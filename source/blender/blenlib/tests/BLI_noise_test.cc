@@ -0,0 +1,67 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+
+namespace blender::noise::tests {
+
+static Array<float3> random_positions(const int size, const float range)
+{
+  RandomNumberGenerator rng(42);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = (float3(rng.get_float(), rng.get_float(), rng.get_float()) * 2.0f - 1.0f) * range;
+  }
+  return positions;
+}
+
+TEST(noise, PerlinSignedBatchMatchesSingle)
+{
+  /* Use a size that is not a multiple of the SIMD width to test the remainder too. */
+  const Array<float3> positions = random_positions(1003, 50.0f);
+  Array<float> values(positions.size());
+  perlin_signed(positions, values);
+  for (const int64_t i : positions.index_range()) {
+    EXPECT_NEAR(values[i], perlin_signed(positions[i]), 1e-5f);
+  }
+}
+
+TEST(noise, PerlinSignedBatchLargeCoordinates)
+{
+  const Array<float3> positions = {
+      float3(1234567.0f, -2345678.0f, 100001.5f), float3(-99999.9f, 0.0f, -0.25f)};
+  Array<float> values(positions.size());
+  perlin_signed(positions, values);
+  for (const int64_t i : positions.index_range()) {
+    EXPECT_NEAR(values[i], perlin_signed(positions[i]), 1e-5f);
+  }
+}
+
+TEST(noise, PerlinFractalDistortedBatchMatchesSingle)
+{
+  const Array<float3> positions = random_positions(517, 10.0f);
+  Array<float> values(positions.size());
+  for (const float detail : {0.0f, 2.0f, 3.5f}) {
+    for (const float distortion : {0.0f, 1.5f}) {
+      for (const bool normalize : {false, true}) {
+        /* Type 1 is fBM which has a batched implementation, type 0 uses the fallback. */
+        for (const int type : {0, 1}) {
+          perlin_fractal_distorted(
+              positions, detail, 0.5f, 2.0f, 0.0f, 1.0f, distortion, type, normalize, values);
+          for (const int64_t i : positions.index_range()) {
+            const float expected = perlin_fractal_distorted(
+                positions[i], detail, 0.5f, 2.0f, 0.0f, 1.0f, distortion, type, normalize);
+            EXPECT_NEAR(values[i], expected, 1e-4f);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace blender::noise::tests
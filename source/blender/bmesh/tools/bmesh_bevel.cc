@@ -20,6 +20,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_memarena.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -35,6 +36,7 @@
 
 #include "./intern/bmesh_private.hh"
 
+using blender::IndexRange;
 using blender::Vector;
 
 // #define BEVEL_DEBUG_TIME
@@ -2482,98 +2484,103 @@ static void bevel_harden_normals(BevelParams *bp, BMesh *bm)
     cd_clnors_offset = CustomData_get_offset(&bm->ldata, CD_CUSTOMLOOPNORMAL);
   }
 
-  BMIter fiter;
-  BMFace *f;
-  BM_ITER_MESH (f, &fiter, bm, BM_FACES_OF_MESH) {
-    FKind fkind = get_face_kind(bp, f);
-    if (ELEM(fkind, F_ORIG, F_RECON)) {
-      continue;
-    }
-    BMIter liter;
-    BMLoop *l;
-    BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
-      BMEdge *estep = l->prev->e; /* Causes CW walk around l->v fan. */
-      BMLoop *lprev = BM_vert_step_fan_loop(l, &estep);
-      estep = l->e; /* Causes CCW walk around l->v fan. */
-      BMLoop *lnext = BM_vert_step_fan_loop(l, &estep);
-      FKind fprevkind = lprev ? get_face_kind(bp, lprev->f) : F_NONE;
-      FKind fnextkind = lnext ? get_face_kind(bp, lnext->f) : F_NONE;
-
-      float norm[3];
-      float *pnorm = nullptr;
-      if (fkind == F_EDGE) {
-        if (fprevkind == F_EDGE && BM_elem_flag_test(l, BM_ELEM_LONG_TAG)) {
-          add_v3_v3v3(norm, f->no, lprev->f->no);
-          pnorm = norm;
-        }
-        else if (fnextkind == F_EDGE && BM_elem_flag_test(lnext, BM_ELEM_LONG_TAG)) {
-          add_v3_v3v3(norm, f->no, lnext->f->no);
-          pnorm = norm;
-        }
-        else if (fprevkind == F_RECON && BM_elem_flag_test(l, BM_ELEM_LONG_TAG)) {
-          pnorm = lprev->f->no;
-        }
-        else if (fnextkind == F_RECON && BM_elem_flag_test(l->prev, BM_ELEM_LONG_TAG)) {
-          pnorm = lnext->f->no;
-        }
-        else {
-          // printf("unexpected harden case (edge)\n");
-        }
+  /* Every face only writes the custom normals of its own corners, and the face kind lookups in
+   * the face hash are thread-safe. */
+  BM_mesh_elem_table_ensure(bm, BM_FACE);
+  blender::threading::parallel_for(IndexRange(bm->totface), 256, [&](const IndexRange range) {
+    for (const int face_index : range) {
+      BMFace *f = BM_face_at_index(bm, face_index);
+      FKind fkind = get_face_kind(bp, f);
+      if (ELEM(fkind, F_ORIG, F_RECON)) {
+        continue;
       }
-      else if (fkind == F_VERT) {
-        if (fprevkind == F_VERT && fnextkind == F_VERT) {
-          pnorm = l->v->no;
-        }
-        else if (fprevkind == F_RECON) {
-          pnorm = lprev->f->no;
-        }
-        else if (fnextkind == F_RECON) {
-          pnorm = lnext->f->no;
-        }
-        else {
-          BMLoop *lprevprev, *lnextnext;
-          if (lprev) {
-            estep = lprev->prev->e;
-            lprevprev = BM_vert_step_fan_loop(lprev, &estep);
+      BMIter liter;
+      BMLoop *l;
+      BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+        BMEdge *estep = l->prev->e; /* Causes CW walk around l->v fan. */
+        BMLoop *lprev = BM_vert_step_fan_loop(l, &estep);
+        estep = l->e; /* Causes CCW walk around l->v fan. */
+        BMLoop *lnext = BM_vert_step_fan_loop(l, &estep);
+        FKind fprevkind = lprev ? get_face_kind(bp, lprev->f) : F_NONE;
+        FKind fnextkind = lnext ? get_face_kind(bp, lnext->f) : F_NONE;
+
+        float norm[3];
+        float *pnorm = nullptr;
+        if (fkind == F_EDGE) {
+          if (fprevkind == F_EDGE && BM_elem_flag_test(l, BM_ELEM_LONG_TAG)) {
+            add_v3_v3v3(norm, f->no, lprev->f->no);
+            pnorm = norm;
           }
-          else {
-            lprevprev = nullptr;
+          else if (fnextkind == F_EDGE && BM_elem_flag_test(lnext, BM_ELEM_LONG_TAG)) {
+            add_v3_v3v3(norm, f->no, lnext->f->no);
+            pnorm = norm;
           }
-          if (lnext) {
-            estep = lnext->e;
-            lnextnext = BM_vert_step_fan_loop(lnext, &estep);
+          else if (fprevkind == F_RECON && BM_elem_flag_test(l, BM_ELEM_LONG_TAG)) {
+            pnorm = lprev->f->no;
+          }
+          else if (fnextkind == F_RECON && BM_elem_flag_test(l->prev, BM_ELEM_LONG_TAG)) {
+            pnorm = lnext->f->no;
           }
           else {
-            lnextnext = nullptr;
+            // printf("unexpected harden case (edge)\n");
           }
-          FKind fprevprevkind = lprevprev ? get_face_kind(bp, lprevprev->f) : F_NONE;
-          FKind fnextnextkind = lnextnext ? get_face_kind(bp, lnextnext->f) : F_NONE;
-          if (fprevkind == F_EDGE && fprevprevkind == F_RECON) {
-            pnorm = lprevprev->f->no;
+        }
+        else if (fkind == F_VERT) {
+          if (fprevkind == F_VERT && fnextkind == F_VERT) {
+            pnorm = l->v->no;
           }
-          else if (fprevkind == F_EDGE && fnextkind == F_VERT && fprevprevkind == F_EDGE) {
-            add_v3_v3v3(norm, lprev->f->no, lprevprev->f->no);
-            pnorm = norm;
+          else if (fprevkind == F_RECON) {
+            pnorm = lprev->f->no;
           }
-          else if (fnextkind == F_EDGE && fprevkind == F_VERT && fnextnextkind == F_EDGE) {
-            add_v3_v3v3(norm, lnext->f->no, lnextnext->f->no);
-            pnorm = norm;
+          else if (fnextkind == F_RECON) {
+            pnorm = lnext->f->no;
           }
           else {
-            // printf("unexpected harden case (vert)\n");
+            BMLoop *lprevprev, *lnextnext;
+            if (lprev) {
+              estep = lprev->prev->e;
+              lprevprev = BM_vert_step_fan_loop(lprev, &estep);
+            }
+            else {
+              lprevprev = nullptr;
+            }
+            if (lnext) {
+              estep = lnext->e;
+              lnextnext = BM_vert_step_fan_loop(lnext, &estep);
+            }
+            else {
+              lnextnext = nullptr;
+            }
+            FKind fprevprevkind = lprevprev ? get_face_kind(bp, lprevprev->f) : F_NONE;
+            FKind fnextnextkind = lnextnext ? get_face_kind(bp, lnextnext->f) : F_NONE;
+            if (fprevkind == F_EDGE && fprevprevkind == F_RECON) {
+              pnorm = lprevprev->f->no;
+            }
+            else if (fprevkind == F_EDGE && fnextkind == F_VERT && fprevprevkind == F_EDGE) {
+              add_v3_v3v3(norm, lprev->f->no, lprevprev->f->no);
+              pnorm = norm;
+            }
+            else if (fnextkind == F_EDGE && fprevkind == F_VERT && fnextnextkind == F_EDGE) {
+              add_v3_v3v3(norm, lnext->f->no, lnextnext->f->no);
+              pnorm = norm;
+            }
+            else {
+              // printf("unexpected harden case (vert)\n");
+            }
           }
         }
-      }
-      if (pnorm) {
-        if (pnorm == norm) {
-          normalize_v3(norm);
+        if (pnorm) {
+          if (pnorm == norm) {
+            normalize_v3(norm);
+          }
+          int l_index = BM_elem_index_get(l);
+          short *clnors = static_cast<short *>(BM_ELEM_CD_GET_VOID_P(l, cd_clnors_offset));
+          BKE_lnor_space_custom_normal_to_data(
+              bm->lnor_spacearr->lspacearr[l_index], pnorm, clnors);
         }
-        int l_index = BM_elem_index_get(l);
-        short *clnors = static_cast<short *>(BM_ELEM_CD_GET_VOID_P(l, cd_clnors_offset));
-        BKE_lnor_space_custom_normal_to_data(bm->lnor_spacearr->lspacearr[l_index], pnorm, clnors);
       }
     }
-  }
+  });
 }
 
 static void bevel_set_weighted_normal_face_strength(BMesh *bm, BevelParams *bp)
@@ -7618,33 +7625,38 @@ static float vertex_collide_offset(BevelParams *bp, EdgeHalf *ea)
  */
 static void bevel_limit_offset(BevelParams *bp, BMesh *bm)
 {
-  float limited_offset = bp->offset;
   BMIter iter;
   BMVert *bmv;
+  Vector<BevVert *> bevverts;
   BM_ITER_MESH (bmv, &iter, bm, BM_VERTS_OF_MESH) {
     if (!BM_elem_flag_test(bmv, BM_ELEM_TAG)) {
       continue;
     }
-    BevVert *bv = find_bevvert(bp, bmv);
-    if (!bv) {
-      continue;
-    }
-    for (int i = 0; i < bv->edgecount; i++) {
-      EdgeHalf *eh = &bv->edges[i];
-      if (bp->affect_type == BEVEL_AFFECT_VERTICES) {
-        float collision_offset = vertex_collide_offset(bp, eh);
-        if (collision_offset < limited_offset) {
-          limited_offset = collision_offset;
-        }
-      }
-      else {
-        float collision_offset = geometry_collide_offset(bp, eh);
-        if (collision_offset < limited_offset) {
-          limited_offset = collision_offset;
+    if (BevVert *bv = find_bevvert(bp, bmv)) {
+      bevverts.append(bv);
+    }
+  }
+
+  /* The collision offsets only read the mesh and the bevel vertex data, and the lookups in the
+   * vertex hash are thread-safe, so they can be computed in parallel. */
+  const float limited_offset = blender::threading::parallel_reduce(
+      bevverts.index_range(),
+      256,
+      bp->offset,
+      [&](const IndexRange range, float limit) {
+        for (const int bv_index : range) {
+          BevVert *bv = bevverts[bv_index];
+          for (int i = 0; i < bv->edgecount; i++) {
+            EdgeHalf *eh = &bv->edges[i];
+            const float collision_offset = (bp->affect_type == BEVEL_AFFECT_VERTICES) ?
+                                               vertex_collide_offset(bp, eh) :
+                                               geometry_collide_offset(bp, eh);
+            limit = std::min(limit, collision_offset);
+          }
         }
-      }
-    }
-  }
+        return limit;
+      },
+      [](const float a, const float b) { return std::min(a, b); });
 
   if (limited_offset < bp->offset) {
     /* All current offset specs have some number times bp->offset,
@@ -7653,14 +7665,7 @@ static void bevel_limit_offset(BevelParams *bp, BMesh *bm)
      * with the new limited_offset.
      */
     float offset_factor = limited_offset / bp->offset;
-    BM_ITER_MESH (bmv, &iter, bm, BM_VERTS_OF_MESH) {
-      if (!BM_elem_flag_test(bmv, BM_ELEM_TAG)) {
-        continue;
-      }
-      BevVert *bv = find_bevvert(bp, bmv);
-      if (!bv) {
-        continue;
-      }
+    for (BevVert *bv : bevverts) {
       for (int i = 0; i < bv->edgecount; i++) {
         EdgeHalf *eh = &bv->edges[i];
         eh->offset_l_spec *= offset_factor;
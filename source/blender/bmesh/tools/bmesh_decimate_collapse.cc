@@ -13,6 +13,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
@@ -21,6 +22,7 @@
 #include "BLI_polyfill_2d.h"
 #include "BLI_polyfill_2d_beautify.h"
 #include "BLI_quadric.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "BKE_customdata.hh"
@@ -30,6 +32,9 @@
 
 #include "../intern/bmesh_structure.hh"
 
+using blender::Array;
+using blender::IndexRange;
+
 #define USE_SYMMETRY
 #ifdef USE_SYMMETRY
 #  include "BLI_kdtree.h"
@@ -75,23 +80,31 @@ static void bm_decim_build_quadrics(BMesh *bm, Quadric *vquadrics)
   BMFace *f;
   BMEdge *e;
 
-  BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+  /* Calculate the face quadrics in parallel, then accumulate them serially in face order
+   * so the result doesn't depend on threading. */
+  BM_mesh_elem_table_ensure(bm, BM_FACE);
+  Array<Quadric> face_quadrics(bm->totface);
+  blender::threading::parallel_for(IndexRange(bm->totface), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const BMFace *face = BM_face_at_index(bm, i);
+      float center[3];
+      double plane_db[4];
+
+      BM_face_calc_center_median(face, center);
+      copy_v3db_v3fl(plane_db, face->no);
+      plane_db[3] = -dot_v3db_v3fl(plane_db, center);
+
+      BLI_quadric_from_plane(&face_quadrics[i], plane_db);
+    }
+  });
+
+  for (const int i : face_quadrics.index_range()) {
+    f = BM_face_at_index(bm, i);
     BMLoop *l_first;
     BMLoop *l_iter;
-
-    float center[3];
-    double plane_db[4];
-    Quadric q;
-
-    BM_face_calc_center_median(f, center);
-    copy_v3db_v3fl(plane_db, f->no);
-    plane_db[3] = -dot_v3db_v3fl(plane_db, center);
-
-    BLI_quadric_from_plane(&q, plane_db);
-
     l_iter = l_first = BM_FACE_FIRST_LOOP(f);
     do {
-      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &q);
+      BLI_quadric_add_qu_qu(&vquadrics[BM_elem_index_get(l_iter->v)], &face_quadrics[i]);
     } while ((l_iter = l_iter->next) != l_first);
   }
 
@@ -227,19 +240,23 @@ static float bm_decim_build_edge_cost_single__topology(BMEdge *e)
 
 #endif /* USE_TOPOLOGY_FALLBACK */
 
-static void bm_decim_build_edge_cost_single(BMEdge *e,
-                                            const Quadric *vquadrics,
-                                            const float *vweights,
-                                            const float vweight_factor,
-                                            Heap *eheap,
-                                            HeapNode **eheap_table)
+/**
+ * Calculate the cost of collapsing \a e, this only reads the mesh so it can run in parallel.
+ *
+ * \return false when the edge should not be collapsed at all.
+ */
+static bool bm_decim_calc_edge_cost(BMEdge *e,
+                                    const Quadric *vquadrics,
+                                    const float *vweights,
+                                    const float vweight_factor,
+                                    float *r_cost)
 {
   float cost;
 
   if (UNLIKELY(vweights && ((vweights[BM_elem_index_get(e->v1)] == 0.0f) ||
                             (vweights[BM_elem_index_get(e->v2)] == 0.0f))))
   {
-    goto clear;
+    return false;
   }
 
   /* Check we can collapse, some edges we better not touch. */
@@ -249,7 +266,7 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else if (BM_edge_is_manifold(e)) {
@@ -258,11 +275,11 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
     else {
       /* Only collapse triangles. */
-      goto clear;
+      return false;
     }
   }
   else {
-    goto clear;
+    return false;
   }
   /* End sanity check. */
 
@@ -315,10 +332,23 @@ static void bm_decim_build_edge_cost_single(BMEdge *e,
     }
   }
 
-  BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
-  return;
+  *r_cost = cost;
+  return true;
+}
+
+static void bm_decim_build_edge_cost_single(BMEdge *e,
+                                            const Quadric *vquadrics,
+                                            const float *vweights,
+                                            const float vweight_factor,
+                                            Heap *eheap,
+                                            HeapNode **eheap_table)
+{
+  float cost;
+  if (bm_decim_calc_edge_cost(e, vquadrics, vweights, vweight_factor, &cost)) {
+    BLI_heap_insert_or_update(eheap, &eheap_table[BM_elem_index_get(e)], cost, e);
+    return;
+  }
 
-clear:
   if (eheap_table[BM_elem_index_get(e)]) {
     BLI_heap_remove(eheap, eheap_table[BM_elem_index_get(e)]);
   }
@@ -340,14 +370,25 @@ static void bm_decim_build_edge_cost(BMesh *bm,
                                      Heap *eheap,
                                      HeapNode **eheap_table)
 {
-  BMIter iter;
-  BMEdge *e;
-  uint i;
+  /* Calculating the costs is the expensive part, do it in parallel and only fill the heap
+   * serially (in edge order, so the result doesn't depend on threading). */
+  BM_mesh_elem_table_ensure(bm, BM_EDGE);
+  Array<float> costs(bm->totedge);
+  Array<bool> is_valid(bm->totedge);
+  blender::threading::parallel_for(IndexRange(bm->totedge), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      is_valid[i] = bm_decim_calc_edge_cost(
+          BM_edge_at_index(bm, i), vquadrics, vweights, vweight_factor, &costs[i]);
+    }
+  });
 
-  BM_ITER_MESH_INDEX (e, &iter, bm, BM_EDGES_OF_MESH, i) {
+  for (const int i : costs.index_range()) {
+    BMEdge *e = BM_edge_at_index(bm, i);
     /* keep sanity check happy */
-    eheap_table[i] = nullptr;
-    bm_decim_build_edge_cost_single(e, vquadrics, vweights, vweight_factor, eheap, eheap_table);
+    eheap_table[BM_elem_index_get(e)] = nullptr;
+    if (is_valid[i]) {
+      eheap_table[BM_elem_index_get(e)] = BLI_heap_insert(eheap, costs[i], e);
+    }
   }
 }
 
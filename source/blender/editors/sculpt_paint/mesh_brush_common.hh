@@ -238,6 +238,18 @@ void calc_brush_distances_squared(const SculptSession &ss,
                                   eBrushFalloffShape falloff_shape,
                                   MutableSpan<float> r_distances);
 
+/**
+ * Calculate the squared distance from a location to every position. Four positions are processed
+ * at once when SIMD instructions are available.
+ */
+void calc_distances_squared(const float3 &location,
+                            Span<float3> positions,
+                            MutableSpan<float> r_distances);
+void calc_distances_squared(const float3 &location,
+                            Span<float3> vert_positions,
+                            Span<int> verts,
+                            MutableSpan<float> r_distances);
+
 /** Set the factor to zero for all distances greater than the radius. */
 void filter_distances_with_radius(float radius, Span<float> distances, MutableSpan<float> factors);
 
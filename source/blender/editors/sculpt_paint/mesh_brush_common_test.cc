@@ -0,0 +1,61 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edsculpt
+ */
+
+#include "BLI_array.hh"
+#include "BLI_math_vector.hh"
+
+#include "mesh_brush_common.hh"
+
+#include "testing/testing.h"
+
+namespace blender::ed::sculpt_paint::tests {
+
+static Array<float3> create_positions(const int size)
+{
+  Array<float3> positions(size);
+  for (const int i : positions.index_range()) {
+    positions[i] = float3(float(i) * 0.5f, float(i % 3) - 1.0f, float(i * i) * 0.01f);
+  }
+  return positions;
+}
+
+TEST(brush_common, DistancesSquared)
+{
+  const float3 location(0.25f, -2.0f, 1.5f);
+  /* Test sizes that don't fill a whole SIMD register as well. */
+  for (const int size : {0, 1, 3, 4, 7, 16, 33}) {
+    const Array<float3> positions = create_positions(size);
+    Array<float> distances(size);
+    calc_distances_squared(location, positions, distances);
+    for (const int i : positions.index_range()) {
+      EXPECT_FLOAT_EQ(distances[i], math::distance_squared(location, positions[i]));
+    }
+  }
+}
+
+TEST(brush_common, DistancesSquaredIndexed)
+{
+  const float3 location(1.0f, 0.0f, -1.0f);
+  const Array<float3> positions = create_positions(20);
+  const Array<int> verts = {19, 0, 4, 7, 7, 2, 11, 15, 3};
+  Array<float> distances(verts.size());
+  calc_distances_squared(location, positions, verts, distances);
+  for (const int i : verts.index_range()) {
+    EXPECT_FLOAT_EQ(distances[i], math::distance_squared(location, positions[verts[i]]));
+  }
+}
+
+TEST(brush_common, FilterDistancesWithRadius)
+{
+  const Array<float> distances = {0.0f, 1.0f, 2.0f, 0.5f, 3.0f, 1.5f, 0.9f};
+  Array<float> factors = {1.0f, 0.5f, 1.0f, 0.0f, 0.25f, 1.0f, 0.75f};
+  filter_distances_with_radius(1.0f, distances, factors);
+  EXPECT_EQ(factors.as_span(), Span<float>({1.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.75f}));
+}
+
+}  // namespace blender::ed::sculpt_paint::tests
@@ -29,6 +29,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_rotation.hh"
 #include "BLI_set.hh"
+#include "BLI_simd.hh"
 #include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -6833,6 +6834,103 @@ void filter_region_clip_factors(const SculptSession &ss,
   }
 }
 
+#if BLI_HAVE_SSE2
+/**
+ * Load four consecutive positions and transpose them so that each register contains one
+ * component of all four positions.
+ */
+static inline void load_float3_x4(const float3 *src, __m128 &r_x, __m128 &r_y, __m128 &r_z)
+{
+  const float *ptr = reinterpret_cast<const float *>(src);
+  const __m128 a = _mm_loadu_ps(ptr);     /* x0 y0 z0 x1 */
+  const __m128 b = _mm_loadu_ps(ptr + 4); /* y1 z1 x2 y2 */
+  const __m128 c = _mm_loadu_ps(ptr + 8); /* z2 x3 y3 z3 */
+  r_x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+  r_y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                       _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                       _MM_SHUFFLE(2, 0, 2, 0));
+  r_z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                       _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)),
+                       _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline __m128 distance_squared_x4(const __m128 x,
+                                         const __m128 y,
+                                         const __m128 z,
+                                         const __m128 location_x,
+                                         const __m128 location_y,
+                                         const __m128 location_z)
+{
+  const __m128 dx = _mm_sub_ps(location_x, x);
+  const __m128 dy = _mm_sub_ps(location_y, y);
+  const __m128 dz = _mm_sub_ps(location_z, z);
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+}
+#endif
+
+void calc_distances_squared(const float3 &location,
+                            const Span<float3> positions,
+                            const MutableSpan<float> r_distances)
+{
+  BLI_assert(positions.size() == r_distances.size());
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 location_x = _mm_set1_ps(location.x);
+  const __m128 location_y = _mm_set1_ps(location.y);
+  const __m128 location_z = _mm_set1_ps(location.z);
+  for (; i + 4 <= positions.size(); i += 4) {
+    __m128 x, y, z;
+    load_float3_x4(&positions[i], x, y, z);
+    _mm_storeu_ps(&r_distances[i],
+                  distance_squared_x4(x, y, z, location_x, location_y, location_z));
+  }
+#endif
+  for (; i < positions.size(); i++) {
+    r_distances[i] = math::distance_squared(location, positions[i]);
+  }
+}
+
+void calc_distances_squared(const float3 &location,
+                            const Span<float3> vert_positions,
+                            const Span<int> verts,
+                            const MutableSpan<float> r_distances)
+{
+  BLI_assert(verts.size() == r_distances.size());
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 location_x = _mm_set1_ps(location.x);
+  const __m128 location_y = _mm_set1_ps(location.y);
+  const __m128 location_z = _mm_set1_ps(location.z);
+  for (; i + 4 <= verts.size(); i += 4) {
+    const float3 &p0 = vert_positions[verts[i]];
+    const float3 &p1 = vert_positions[verts[i + 1]];
+    const float3 &p2 = vert_positions[verts[i + 2]];
+    const float3 &p3 = vert_positions[verts[i + 3]];
+    const __m128 x = _mm_setr_ps(p0.x, p1.x, p2.x, p3.x);
+    const __m128 y = _mm_setr_ps(p0.y, p1.y, p2.y, p3.y);
+    const __m128 z = _mm_setr_ps(p0.z, p1.z, p2.z, p3.z);
+    _mm_storeu_ps(&r_distances[i],
+                  distance_squared_x4(x, y, z, location_x, location_y, location_z));
+  }
+#endif
+  for (; i < verts.size(); i++) {
+    r_distances[i] = math::distance_squared(location, vert_positions[verts[i]]);
+  }
+}
+
+static void sqrt_values(const MutableSpan<float> values)
+{
+  int i = 0;
+#if BLI_HAVE_SSE2
+  for (; i + 4 <= values.size(); i += 4) {
+    _mm_storeu_ps(&values[i], _mm_sqrt_ps(_mm_loadu_ps(&values[i])));
+  }
+#endif
+  for (; i < values.size(); i++) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+
 void calc_brush_distances_squared(const SculptSession &ss,
                                   const Span<float3> positions,
                                   const Span<int> verts,
@@ -6855,9 +6953,7 @@ void calc_brush_distances_squared(const SculptSession &ss,
     }
   }
   else {
-    for (const int i : verts.index_range()) {
-      r_distances[i] = math::distance_squared(test_location, positions[verts[i]]);
-    }
+    calc_distances_squared(test_location, positions, verts, r_distances);
   }
 }
 
@@ -6868,9 +6964,7 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, verts, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_values(r_distances);
 }
 
 void calc_brush_distances_squared(const SculptSession &ss,
@@ -6894,9 +6988,7 @@ void calc_brush_distances_squared(const SculptSession &ss,
     }
   }
   else {
-    for (const int i : positions.index_range()) {
-      r_distances[i] = math::distance_squared(test_location, positions[i]);
-    }
+    calc_distances_squared(test_location, positions, r_distances);
   }
 }
 
@@ -6906,16 +6998,23 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_values(r_distances);
 }
 
 void filter_distances_with_radius(const float radius,
                                   const Span<float> distances,
                                   const MutableSpan<float> factors)
 {
-  for (const int i : distances.index_range()) {
+  BLI_assert(distances.size() == factors.size());
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 radius_v = _mm_set1_ps(radius);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 outside = _mm_cmpgt_ps(_mm_loadu_ps(&distances[i]), radius_v);
+    _mm_storeu_ps(&factors[i], _mm_andnot_ps(outside, _mm_loadu_ps(&factors[i])));
+  }
+#endif
+  for (; i < distances.size(); i++) {
     if (distances[i] > radius) {
       factors[i] = 0.0f;
     }
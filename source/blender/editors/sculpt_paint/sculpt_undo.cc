@@ -33,9 +33,12 @@
 
 #include <mutex>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_array_utils.hh"
 #include "BLI_bit_group_vector.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
@@ -133,6 +136,13 @@ namespace blender::ed::sculpt_paint::undo {
 
 #define NO_ACTIVE_LAYER bke::AttrDomain::Auto
 
+/** Compressed data of an array in a finished undo step, see #compress_nodes. */
+struct CompressedArray {
+  Array<uint8_t, 0> data;
+  /** Number of elements in the uncompressed array. */
+  int64_t size = 0;
+};
+
 struct Node {
   Array<float3, 0> position;
   Array<float3, 0> orig_position;
@@ -142,6 +152,13 @@ struct Node {
 
   Array<float4, 0> loop_col;
 
+  /** Storage of the arrays above while the undo step isn't being restored. */
+  CompressedArray position_compressed;
+  CompressedArray orig_position_compressed;
+  CompressedArray col_compressed;
+  CompressedArray mask_compressed;
+  CompressedArray loop_col_compressed;
+
   /* Mesh. */
 
   Array<int, 0> vert_indices;
@@ -260,6 +277,12 @@ struct StepData {
   Vector<std::unique_ptr<Node>> nodes;
 
   size_t undo_size;
+
+  /**
+   * The node arrays were decompressed to restore this step. They are kept uncompressed until the
+   * next undo push, so that repeatedly undoing and redoing doesn't compress them every time.
+   */
+  bool is_decompressed = false;
 };
 
 struct SculptUndoStep {
@@ -1882,9 +1905,153 @@ static size_t node_size_in_bytes(const Node &node)
   size += node.grid_hidden.all_bits().size() / 8;
   size += node.face_sets.as_span().size_in_bytes();
   size += node.face_indices.as_span().size_in_bytes();
+  size += node.position_compressed.data.as_span().size_in_bytes();
+  size += node.orig_position_compressed.data.as_span().size_in_bytes();
+  size += node.col_compressed.data.as_span().size_in_bytes();
+  size += node.mask_compressed.data.as_span().size_in_bytes();
+  size += node.loop_col_compressed.data.as_span().size_in_bytes();
   return size;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Node Compression
+ *
+ * Positions, masks and colors of finished undo steps make up most of the sculpt undo memory,
+ * but they are only accessed when the step is undone or redone. In the mean time they are stored
+ * compressed. Restored steps are compressed again when the next undo step is pushed.
+ * \{ */
+
+/** Compressing small arrays isn't worth the overhead. */
+static constexpr int64_t compress_min_bytes = 4096;
+/** Favor speed, compression runs at the end of every stroke. */
+static constexpr int compress_zstd_level = 1;
+
+template<typename T>
+static void compress_array(ZSTD_CCtx *ctx, Array<T, 0> &array, CompressedArray &r_compressed)
+{
+  static_assert(sizeof(T) % sizeof(float) == 0);
+  const Span<uint8_t> raw(reinterpret_cast<const uint8_t *>(array.data()),
+                          array.as_span().size_in_bytes());
+  if (raw.size() < compress_min_bytes) {
+    return;
+  }
+  Array<uint8_t> shuffled(raw.size(), NoInitialization());
+  array_utils::shuffle_bytes(raw, sizeof(float), shuffled);
+
+  Array<uint8_t> buffer(ZSTD_compressBound(raw.size()), NoInitialization());
+  const size_t compressed_size = ZSTD_compressCCtx(ctx,
+                                                   buffer.data(),
+                                                   buffer.size(),
+                                                   shuffled.data(),
+                                                   shuffled.size(),
+                                                   compress_zstd_level);
+  if (ZSTD_isError(compressed_size) || compressed_size >= size_t(raw.size())) {
+    return;
+  }
+  r_compressed.data = buffer.as_span().take_front(compressed_size);
+  r_compressed.size = array.size();
+  array = {};
+}
+
+template<typename T>
+static void decompress_array(ZSTD_DCtx *ctx, CompressedArray &compressed, Array<T, 0> &r_array)
+{
+  if (compressed.data.is_empty()) {
+    return;
+  }
+  r_array.reinitialize(compressed.size);
+  const MutableSpan<uint8_t> raw(reinterpret_cast<uint8_t *>(r_array.data()),
+                                 r_array.as_span().size_in_bytes());
+  Array<uint8_t> shuffled(raw.size(), NoInitialization());
+  const size_t decompressed_size = ZSTD_decompressDCtx(
+      ctx, shuffled.data(), shuffled.size(), compressed.data.data(), compressed.data.size());
+  BLI_assert(!ZSTD_isError(decompressed_size) && decompressed_size == size_t(raw.size()));
+  UNUSED_VARS_NDEBUG(decompressed_size);
+  array_utils::unshuffle_bytes(shuffled, sizeof(float), raw);
+  compressed = {};
+}
+
+static void compress_nodes(const Span<std::unique_ptr<Node>> nodes)
+{
+  threading::parallel_for(nodes.index_range(), 8, [&](const IndexRange range) {
+    ZSTD_CCtx *ctx = ZSTD_createCCtx();
+    for (const int i : range) {
+      Node &unode = *nodes[i];
+      compress_array(ctx, unode.position, unode.position_compressed);
+      compress_array(ctx, unode.orig_position, unode.orig_position_compressed);
+      compress_array(ctx, unode.col, unode.col_compressed);
+      compress_array(ctx, unode.mask, unode.mask_compressed);
+      compress_array(ctx, unode.loop_col, unode.loop_col_compressed);
+    }
+    ZSTD_freeCCtx(ctx);
+  });
+}
+
+static void decompress_nodes(const Span<std::unique_ptr<Node>> nodes)
+{
+  threading::parallel_for(nodes.index_range(), 8, [&](const IndexRange range) {
+    ZSTD_DCtx *ctx = ZSTD_createDCtx();
+    for (const int i : range) {
+      Node &unode = *nodes[i];
+      decompress_array(ctx, unode.position_compressed, unode.position);
+      decompress_array(ctx, unode.orig_position_compressed, unode.orig_position);
+      decompress_array(ctx, unode.col_compressed, unode.col);
+      decompress_array(ctx, unode.mask_compressed, unode.mask);
+      decompress_array(ctx, unode.loop_col_compressed, unode.loop_col);
+    }
+    ZSTD_freeDCtx(ctx);
+  });
+}
+
+static size_t calc_undo_size(const Span<std::unique_ptr<Node>> nodes)
+{
+  return threading::parallel_reduce(
+      nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+static void update_undo_size(SculptUndoStep &us)
+{
+  us.data.undo_size = calc_undo_size(us.data.nodes);
+  us.step.data_size = us.data.undo_size;
+}
+
+static void ensure_step_decompressed(SculptUndoStep &us)
+{
+  if (us.data.is_decompressed) {
+    return;
+  }
+  decompress_nodes(us.data.nodes);
+  us.data.is_decompressed = true;
+}
+
+/** Compress the data of all steps that were restored since the last undo push. */
+static void compress_restored_steps(UndoStack &ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us_iter, &ustack.steps) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      continue;
+    }
+    SculptUndoStep &us = *reinterpret_cast<SculptUndoStep *>(us_iter);
+    if (!us.data.is_decompressed) {
+      continue;
+    }
+    compress_nodes(us.data.nodes);
+    us.data.is_decompressed = false;
+    update_undo_size(us);
+  }
+}
+
+/** \} */
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1900,18 +2067,8 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
   for (std::unique_ptr<Node> &unode : step_data->nodes) {
     unode->normal = {};
   }
-
-  step_data->undo_size = threading::parallel_reduce(
-      step_data->nodes.index_range(),
-      16,
-      0,
-      [&](const IndexRange range, size_t size) {
-        for (const int i : range) {
-          size += node_size_in_bytes(*step_data->nodes[i]);
-        }
-        return size;
-      },
-      std::plus<size_t>());
+  compress_nodes(step_data->nodes);
+  step_data->undo_size = calc_undo_size(step_data->nodes);
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -1997,6 +2154,9 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
 
+  /* Steps after the active one were freed already, only compress steps that are kept. */
+  compress_restored_steps(*ED_undo_stack_get());
+
   Node *unode = us->data.nodes.is_empty() ? nullptr : us->data.nodes.last().get();
   if (unode && us->data.type == Type::DyntopoEnd) {
     us->step.use_memfile_step = true;
@@ -2014,7 +2174,10 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+  ensure_step_decompressed(*us);
   restore_list(C, depsgraph, us->data);
+  /* Restoring swaps data with the mesh, which can change the size of the step. */
+  update_undo_size(*us);
   us->step.is_applied = false;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
@@ -2024,7 +2187,10 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+  ensure_step_decompressed(*us);
   restore_list(C, depsgraph, us->data);
+  /* Restoring swaps data with the mesh, which can change the size of the step. */
+  update_undo_size(*us);
   us->step.is_applied = true;
 
   print_nodes(*CTX_data_active_object(C), nullptr);
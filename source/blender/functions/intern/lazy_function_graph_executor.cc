@@ -23,7 +23,9 @@
  * Communication between threads is synchronized by using a mutex in every node. When a thread
  * wants to access the state of a node, its mutex has to be locked first (with some documented
  * exceptions). The assumption here is that most nodes are only ever touched by a single thread and
- * therefore the lock contention is reduced the more nodes there are.
+ * therefore the lock contention is reduced the more nodes there are. While a node is locked, only
+ * the executor state is modified. Everything that may run arbitrary code (like destructing values)
+ * is delayed until the lock is released. Therefore, no task isolation is necessary when locking.
  *
  * Similar to how a #LazyFunction can be thought of as a state machine (see `FN_lazy_function.hh`),
  * each node can also be thought of as a state machine. The state of a node contains the evaluation
@@ -207,6 +209,18 @@ struct LockedNode {
    */
   Vector<const OutputSocket *> delayed_required_outputs;
   Vector<const OutputSocket *> delayed_unused_outputs;
+  /**
+   * Graph inputs that the caller should be notified about being unused.
+   */
+  Vector<int, 0> delayed_unused_graph_inputs;
+
+  /**
+   * Values and storage that are not needed anymore. Destructing them may run arbitrary code which
+   * may even spawn new tasks. This must not happen while the node is locked, because the current
+   * thread could start working on another task that tries to lock the same node.
+   */
+  Vector<GMutablePointer, 2> delayed_value_destructions;
+  void *delayed_storage_destruction = nullptr;
 
   LockedNode(const Node &node, NodeState &node_state) : node(node), node_state(node_state) {}
 };
@@ -472,7 +486,10 @@ class Executor {
     for (const int i : node.inputs().index_range()) {
       InputState &input_state = node_state.inputs[i];
       const InputSocket &input_socket = node.input(i);
-      this->destruct_input_value_if_exists(input_state, input_socket.type());
+      if (input_state.value != nullptr) {
+        input_socket.type().destruct(input_state.value);
+        input_state.value = nullptr;
+      }
     }
     std::destroy_at(&node_state);
   }
@@ -723,7 +740,7 @@ class Executor {
               if (node.is_interface()) {
                 const int graph_input_index =
                     self_.graph_input_index_by_socket_index_[socket.index()];
-                params_->set_input_unused(graph_input_index);
+                locked_node.delayed_unused_graph_inputs.append(graph_input_index);
               }
               else {
                 /* Schedule as priority node. This allows freeing up memory earlier which results
@@ -776,18 +793,39 @@ class Executor {
     LockedNode locked_node{node, node_state};
     if (this->use_multi_threading()) {
       std::lock_guard lock{node_state.mutex};
-      threading::isolate_task([&]() { f(locked_node); });
+      f(locked_node);
     }
     else {
       f(locked_node);
     }
 
+    if (!locked_node.delayed_value_destructions.is_empty() ||
+        locked_node.delayed_storage_destruction != nullptr ||
+        !locked_node.delayed_unused_graph_inputs.is_empty())
+    {
+      this->run_delayed_destructions(locked_node);
+    }
+
     this->send_output_required_notifications(
         locked_node.delayed_required_outputs, current_task, local_data);
     this->send_output_unused_notifications(
         locked_node.delayed_unused_outputs, current_task, local_data);
   }
 
+  void run_delayed_destructions(LockedNode &locked_node)
+  {
+    for (GMutablePointer &value : locked_node.delayed_value_destructions) {
+      value.destruct();
+    }
+    if (locked_node.delayed_storage_destruction != nullptr) {
+      const FunctionNode &fn_node = static_cast<const FunctionNode &>(locked_node.node);
+      fn_node.function().destruct_storage(locked_node.delayed_storage_destruction);
+    }
+    for (const int graph_input_index : locked_node.delayed_unused_graph_inputs) {
+      params_->set_input_unused(graph_input_index);
+    }
+  }
+
   void send_output_required_notifications(const Span<const OutputSocket *> sockets,
                                           CurrentTask &current_task,
                                           const LocalData &local_data)
@@ -1005,23 +1043,24 @@ class Executor {
         this->set_input_unused(locked_node, input_socket);
       }
       else if (input_state.usage == ValueUsage::Used) {
-        this->destruct_input_value_if_exists(input_state, input_socket.type());
+        this->destruct_input_value_if_exists(locked_node, input_state, input_socket.type());
       }
     }
 
     if (node_state.storage != nullptr) {
       if (node.is_function()) {
-        const FunctionNode &fn_node = static_cast<const FunctionNode &>(node);
-        fn_node.function().destruct_storage(node_state.storage);
+        locked_node.delayed_storage_destruction = node_state.storage;
       }
       node_state.storage = nullptr;
     }
   }
 
-  void destruct_input_value_if_exists(InputState &input_state, const CPPType &type)
+  void destruct_input_value_if_exists(LockedNode &locked_node,
+                                      InputState &input_state,
+                                      const CPPType &type)
   {
     if (input_state.value != nullptr) {
-      type.destruct(input_state.value);
+      locked_node.delayed_value_destructions.append({type, input_state.value});
       input_state.value = nullptr;
     }
   }
@@ -1056,7 +1095,7 @@ class Executor {
     }
     input_state.usage = ValueUsage::Unused;
 
-    this->destruct_input_value_if_exists(input_state, input_socket.type());
+    this->destruct_input_value_if_exists(locked_node, input_state, input_socket.type());
     if (input_state.was_ready_for_execution) {
       return;
     }
@@ -1161,22 +1200,29 @@ class Executor {
         }
         continue;
       }
+      /* No need to make a copy if this is the last target. The copy is made before locking the
+       * node, because copying may run arbitrary code. */
+      GMutablePointer value_for_target = value_to_forward;
+      if (is_last_target) {
+        value_to_forward = {};
+      }
+      else {
+        /* Avoid copying the value when it is known already that the target does not need it. The
+         * usage can still become unused before the copy is forwarded, which is handled below. */
+        if (this->is_input_unused(node_state, input_state)) {
+          continue;
+        }
+        void *buffer = local_data.allocator->allocate(type.size(), type.alignment());
+        type.copy_construct(value_to_forward.get(), buffer);
+        value_for_target = {type, buffer};
+      }
       this->with_locked_node(
           target_node, node_state, current_task, local_data, [&](LockedNode &locked_node) {
             if (input_state.usage == ValueUsage::Unused) {
+              locked_node.delayed_value_destructions.append(value_for_target);
               return;
             }
-            if (is_last_target) {
-              /* No need to make a copy if this is the last target. */
-              this->forward_value_to_input(
-                  locked_node, input_state, value_to_forward, current_task);
-              value_to_forward = {};
-            }
-            else {
-              void *buffer = local_data.allocator->allocate(type.size(), type.alignment());
-              type.copy_construct(value_to_forward.get(), buffer);
-              this->forward_value_to_input(locked_node, input_state, {type, buffer}, current_task);
-            }
+            this->forward_value_to_input(locked_node, input_state, value_for_target, current_task);
           });
     }
     if (value_to_forward.get() != nullptr) {
@@ -1184,6 +1230,15 @@ class Executor {
     }
   }
 
+  bool is_input_unused(NodeState &node_state, const InputState &input_state)
+  {
+    if (this->use_multi_threading()) {
+      std::lock_guard lock{node_state.mutex};
+      return input_state.usage == ValueUsage::Unused;
+    }
+    return input_state.usage == ValueUsage::Unused;
+  }
+
   void forward_value_to_input(LockedNode &locked_node,
                               InputState &input_state,
                               GMutablePointer value,
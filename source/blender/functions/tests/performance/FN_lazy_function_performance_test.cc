@@ -0,0 +1,159 @@
+/* SPDX-FileCopyrightText: 2024 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "FN_lazy_function_execute.hh"
+#include "FN_lazy_function_graph.hh"
+#include "FN_lazy_function_graph_executor.hh"
+
+#include "BLI_task.h"
+#include "BLI_timeit.hh"
+
+/**
+ * Synthetic graphs made of many nodes that do almost no work. They measure the overhead of the
+ * graph executor itself, which dominates the evaluation time of node trees with many small nodes.
+ */
+
+namespace blender::fn::lazy_function::tests {
+
+class AddLazyFunction : public LazyFunction {
+ public:
+  AddLazyFunction()
+  {
+    debug_name_ = "Add";
+    inputs_.append({"A", CPPType::get<int>()});
+    inputs_.append({"B", CPPType::get<int>()});
+    outputs_.append({"Result", CPPType::get<int>()});
+  }
+
+  void execute_impl(Params &params, const Context & /*context*/) const override
+  {
+    const int a = params.get_input<int>(0);
+    const int b = params.get_input<int>(1);
+    params.set_output(0, a + b);
+  }
+};
+
+static constexpr int iterations_num = 10;
+
+/**
+ * Evaluate the graph a few times and check that the result is as expected.
+ */
+static void execute_graph_perf(const char *name,
+                               Graph &graph,
+                               GraphInputSocket &input_socket,
+                               GraphOutputSocket &output_socket,
+                               const int input,
+                               const int expected_result)
+{
+  graph.update_node_indices();
+  GraphExecutor executor_fn{graph, {&input_socket}, {&output_socket}, nullptr, nullptr, nullptr};
+  SCOPED_TIMER(name);
+  for ([[maybe_unused]] const int i : IndexRange(iterations_num)) {
+    int result = 0;
+    execute_lazy_function_eagerly(
+        executor_fn, nullptr, nullptr, std::make_tuple(input), std::make_tuple(&result));
+    EXPECT_EQ(result, expected_result);
+  }
+}
+
+/** A single long chain of nodes, nothing can be done in parallel. */
+TEST(lazy_function_perf, chain)
+{
+  BLI_task_scheduler_init();
+  const AddLazyFunction add_fn;
+  const int one = 1;
+  const int nodes_num = 100'000;
+
+  Graph graph;
+  GraphInputSocket &input_socket = graph.add_input(CPPType::get<int>());
+  GraphOutputSocket &output_socket = graph.add_output(CPPType::get<int>());
+  OutputSocket *prev_output = &input_socket;
+  for ([[maybe_unused]] const int i : IndexRange(nodes_num)) {
+    FunctionNode &node = graph.add_function(add_fn);
+    graph.add_link(*prev_output, node.input(0));
+    node.input(1).set_default_value(&one);
+    prev_output = &node.output(0);
+  }
+  graph.add_link(*prev_output, output_socket);
+
+  execute_graph_perf("chain", graph, input_socket, output_socket, 5, 5 + nodes_num);
+}
+
+/** A balanced tree that reduces many leaves to a single value, allowing a lot of parallelism. */
+TEST(lazy_function_perf, reduce_tree)
+{
+  BLI_task_scheduler_init();
+  const AddLazyFunction add_fn;
+  const int zero = 0;
+  const int leaves_num = 1 << 16;
+
+  Graph graph;
+  GraphInputSocket &input_socket = graph.add_input(CPPType::get<int>());
+  GraphOutputSocket &output_socket = graph.add_output(CPPType::get<int>());
+  Vector<OutputSocket *> level;
+  for ([[maybe_unused]] const int i : IndexRange(leaves_num)) {
+    FunctionNode &node = graph.add_function(add_fn);
+    graph.add_link(input_socket, node.input(0));
+    node.input(1).set_default_value(&zero);
+    level.append(&node.output(0));
+  }
+  while (level.size() > 1) {
+    Vector<OutputSocket *> next_level;
+    for (int i = 0; i < level.size(); i += 2) {
+      FunctionNode &node = graph.add_function(add_fn);
+      graph.add_link(*level[i], node.input(0));
+      graph.add_link(*level[i + 1], node.input(1));
+      next_level.append(&node.output(0));
+    }
+    level = std::move(next_level);
+  }
+  graph.add_link(*level[0], output_socket);
+
+  execute_graph_perf("reduce_tree", graph, input_socket, output_socket, 3, 3 * leaves_num);
+}
+
+/** Many independent chains that are joined at the end. */
+TEST(lazy_function_perf, parallel_chains)
+{
+  BLI_task_scheduler_init();
+  const AddLazyFunction add_fn;
+  const int one = 1;
+  const int chains_num = 256;
+  const int chain_length = 256;
+
+  Graph graph;
+  GraphInputSocket &input_socket = graph.add_input(CPPType::get<int>());
+  GraphOutputSocket &output_socket = graph.add_output(CPPType::get<int>());
+  OutputSocket *sum_output = nullptr;
+  for ([[maybe_unused]] const int chain : IndexRange(chains_num)) {
+    OutputSocket *prev_output = &input_socket;
+    for ([[maybe_unused]] const int i : IndexRange(chain_length)) {
+      FunctionNode &node = graph.add_function(add_fn);
+      graph.add_link(*prev_output, node.input(0));
+      node.input(1).set_default_value(&one);
+      prev_output = &node.output(0);
+    }
+    if (sum_output == nullptr) {
+      sum_output = prev_output;
+    }
+    else {
+      FunctionNode &sum_node = graph.add_function(add_fn);
+      graph.add_link(*sum_output, sum_node.input(0));
+      graph.add_link(*prev_output, sum_node.input(1));
+      sum_output = &sum_node.output(0);
+    }
+  }
+  graph.add_link(*sum_output, output_socket);
+
+  execute_graph_perf("parallel_chains",
+                     graph,
+                     input_socket,
+                     output_socket,
+                     1,
+                     chains_num * (1 + chain_length));
+}
+
+}  // namespace blender::fn::lazy_function::tests
@@ -8,6 +8,7 @@
 #include "DNA_collection_types.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_linear_allocator.hh"
 #include "BLI_noise.hh"
 
 #include "BKE_curves.hh"
@@ -63,6 +64,13 @@ struct AttributeFallbacksArray {
   AttributeFallbacksArray(int size) : array(size, nullptr) {}
 };
 
+/**
+ * Realize tasks only reference their attribute fallbacks, because there can be millions of tasks
+ * and storing a separate #AttributeFallbacksArray in each of them would need much more memory than
+ * the realized geometry itself. The arrays are owned by #GatherTasksInfo.allocator.
+ */
+using AttributeFallbacksRef = Span<const void *>;
+
 struct PointCloudRealizeInfo {
   const PointCloud *pointcloud = nullptr;
   /** Matches the order stored in #AllPointCloudsInfo.attributes. */
@@ -80,7 +88,7 @@ struct RealizePointCloudTask {
   const PointCloudRealizeInfo *pointcloud_info;
   /** Transformation that is applied to all positions. */
   float4x4 transform;
-  AttributeFallbacksArray attribute_fallbacks;
+  AttributeFallbacksRef attribute_fallbacks;
   /** Only used when the output contains an output attribute. */
   uint32_t id = 0;
 };
@@ -108,6 +116,11 @@ struct MeshRealizeInfo {
   /** Vertex ids stored on the mesh. If there are no ids, this #Span is empty. */
   Span<int> stored_vertex_ids;
   VArray<int> material_indices;
+  /**
+   * Only used when #material_indices is not a single value. Materialized once per mesh instead of
+   * once per task.
+   */
+  VArraySpan<int> material_indices_span;
 };
 
 struct RealizeMeshTask {
@@ -115,7 +128,7 @@ struct RealizeMeshTask {
   const MeshRealizeInfo *mesh_info;
   /** Transformation that is applied to all positions. */
   float4x4 transform;
-  AttributeFallbacksArray attribute_fallbacks;
+  AttributeFallbacksRef attribute_fallbacks;
   /** Only used when the output contains an output attribute. */
   uint32_t id = 0;
 };
@@ -172,7 +185,7 @@ struct RealizeCurveTask {
   const RealizeCurveInfo *curve_info;
   /** Transformation applied to the position of control points and handles. */
   float4x4 transform;
-  AttributeFallbacksArray attribute_fallbacks;
+  AttributeFallbacksRef attribute_fallbacks;
   /** Only used when the output contains an output attribute. */
   uint32_t id = 0;
 };
@@ -190,7 +203,7 @@ struct RealizeGreasePencilTask {
   int start_index;
   const GreasePencilRealizeInfo *grease_pencil_info;
   float4x4 transform;
-  AttributeFallbacksArray attribute_fallbacks;
+  AttributeFallbacksRef attribute_fallbacks;
 };
 
 struct RealizeEditDataTask {
@@ -312,6 +325,14 @@ struct GatherTasksInfo {
   GatherTasks r_tasks;
   /** Current offsets while gathering tasks. */
   GatherOffsets r_offsets;
+
+  /** Owns the attribute fallback arrays referenced by the tasks. */
+  LinearAllocator<> allocator;
+  /** The last stored fallbacks for each task type, reused by consecutive tasks when possible. */
+  AttributeFallbacksRef last_pointcloud_fallbacks;
+  AttributeFallbacksRef last_mesh_fallbacks;
+  AttributeFallbacksRef last_curve_fallbacks;
+  AttributeFallbacksRef last_grease_pencil_fallbacks;
 };
 
 /**
@@ -407,7 +428,7 @@ static void threaded_fill(const GPointer value, GMutableSpan dst)
 
 static void copy_generic_attributes_to_result(
     const Span<std::optional<GVArraySpan>> src_attributes,
-    const AttributeFallbacksArray &attribute_fallbacks,
+    const AttributeFallbacksRef attribute_fallbacks,
     const OrderedAttributes &ordered_attributes,
     const FunctionRef<IndexRange(bke::AttrDomain)> &range_fn,
     MutableSpan<GSpanAttributeWriter> dst_attribute_writers)
@@ -424,9 +445,9 @@ static void copy_generic_attributes_to_result(
           }
           else {
             const CPPType &cpp_type = dst_span.type();
-            const void *fallback = attribute_fallbacks.array[attribute_index] == nullptr ?
+            const void *fallback = attribute_fallbacks[attribute_index] == nullptr ?
                                        cpp_type.default_value() :
-                                       attribute_fallbacks.array[attribute_index];
+                                       attribute_fallbacks[attribute_index];
             threaded_fill({cpp_type, fallback}, dst_span);
           }
         }
@@ -521,6 +542,20 @@ static Vector<std::pair<int, GSpan>> prepare_attribute_fallbacks(
   return attributes_to_override;
 }
 
+/**
+ * Get fallbacks that can be stored in a task. Consecutive tasks often have the same fallbacks, e.g.
+ * when the instances don't have attributes, so the previously stored array is reused if possible.
+ */
+static AttributeFallbacksRef store_attribute_fallbacks(GatherTasksInfo &gather_info,
+                                                       const AttributeFallbacksArray &fallbacks,
+                                                       AttributeFallbacksRef &r_last_stored)
+{
+  if (r_last_stored != fallbacks.array.as_span()) {
+    r_last_stored = gather_info.allocator.construct_array_copy(fallbacks.array.as_span());
+  }
+  return r_last_stored;
+}
+
 /**
  * Calls #fn for every geometry in the given #InstanceReference. Also passes on the transformation
  * that is applied to every instance.
@@ -645,11 +680,13 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
         if (mesh != nullptr && mesh->verts_num > 0) {
           const int mesh_index = gather_info.meshes.order.index_of(mesh);
           const MeshRealizeInfo &mesh_info = gather_info.meshes.realize_info[mesh_index];
-          gather_info.r_tasks.mesh_tasks.append({gather_info.r_offsets.mesh_offsets,
-                                                 &mesh_info,
-                                                 base_transform,
-                                                 base_instance_context.meshes,
-                                                 base_instance_context.id});
+          gather_info.r_tasks.mesh_tasks.append(
+              {gather_info.r_offsets.mesh_offsets,
+               &mesh_info,
+               base_transform,
+               store_attribute_fallbacks(
+                   gather_info, base_instance_context.meshes, gather_info.last_mesh_fallbacks),
+               base_instance_context.id});
           gather_info.r_offsets.mesh_offsets.vertex += mesh->verts_num;
           gather_info.r_offsets.mesh_offsets.edge += mesh->edges_num;
           gather_info.r_offsets.mesh_offsets.loop += mesh->corners_num;
@@ -665,11 +702,14 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
           const int pointcloud_index = gather_info.pointclouds.order.index_of(pointcloud);
           const PointCloudRealizeInfo &pointcloud_info =
               gather_info.pointclouds.realize_info[pointcloud_index];
-          gather_info.r_tasks.pointcloud_tasks.append({gather_info.r_offsets.pointcloud_offset,
-                                                       &pointcloud_info,
-                                                       base_transform,
-                                                       base_instance_context.pointclouds,
-                                                       base_instance_context.id});
+          gather_info.r_tasks.pointcloud_tasks.append(
+              {gather_info.r_offsets.pointcloud_offset,
+               &pointcloud_info,
+               base_transform,
+               store_attribute_fallbacks(gather_info,
+                                         base_instance_context.pointclouds,
+                                         gather_info.last_pointcloud_fallbacks),
+               base_instance_context.id});
           gather_info.r_offsets.pointcloud_offset += pointcloud->totpoint;
         }
         break;
@@ -680,11 +720,13 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
         if (curves != nullptr && curves->geometry.curve_num > 0) {
           const int curve_index = gather_info.curves.order.index_of(curves);
           const RealizeCurveInfo &curve_info = gather_info.curves.realize_info[curve_index];
-          gather_info.r_tasks.curve_tasks.append({gather_info.r_offsets.curves_offsets,
-                                                  &curve_info,
-                                                  base_transform,
-                                                  base_instance_context.curves,
-                                                  base_instance_context.id});
+          gather_info.r_tasks.curve_tasks.append(
+              {gather_info.r_offsets.curves_offsets,
+               &curve_info,
+               base_transform,
+               store_attribute_fallbacks(
+                   gather_info, base_instance_context.curves, gather_info.last_curve_fallbacks),
+               base_instance_context.id});
           gather_info.r_offsets.curves_offsets.point += curves->geometry.point_num;
           gather_info.r_offsets.curves_offsets.curve += curves->geometry.curve_num;
         }
@@ -702,7 +744,9 @@ static void gather_realize_tasks_recursive(GatherTasksInfo &gather_info,
               {gather_info.r_offsets.grease_pencil_layer_offset,
                &grease_pencil_info,
                base_transform,
-               base_instance_context.grease_pencils});
+               store_attribute_fallbacks(gather_info,
+                                         base_instance_context.grease_pencils,
+                                         gather_info.last_grease_pencil_fallbacks)});
           gather_info.r_offsets.grease_pencil_layer_offset += grease_pencil->layers().size();
         }
         break;
@@ -1350,6 +1394,9 @@ static AllMeshesInfo preprocess_meshes(const bke::GeometrySet &geometry_set,
     }
     mesh_info.material_indices = *attributes.lookup_or_default<int>(
         "material_index", bke::AttrDomain::Face, 0);
+    if (!mesh_info.material_indices.is_single()) {
+      mesh_info.material_indices_span = mesh_info.material_indices;
+    }
   }
 
   info.no_loose_edges_hint = std::all_of(
@@ -1439,7 +1486,7 @@ static void execute_realize_mesh_task(const RealizeInstancesOptions &options,
         dst_material_indices.fill(valid ? material_index_map[src_index] : 0);
       }
       else {
-        VArraySpan<int> indices_span(mesh_info.material_indices);
+        const Span<int> indices_span = mesh_info.material_indices_span;
         threading::parallel_for(src_faces.index_range(), 1024, [&](const IndexRange face_range) {
           for (const int i : face_range) {
             const int src_index = indices_span[i];
@@ -413,6 +413,13 @@ enum class IMBScaleFilter {
    * better results when scaling down by more than 2x.
    */
   Box,
+  /**
+   * Separable cubic filter (Mitchell-Netravali) over 4x4 pixels when scaling up, and a
+   * proportionally wider area when scaling down. Slower than Box, but sharper.
+   */
+  CubicMitchell,
+  /** Separable Lanczos filter with 3 lobes. Slowest and sharpest, may ring at hard edges. */
+  Lanczos3,
 };
 
 /**
@@ -19,6 +19,7 @@ struct AVCodec;
 struct AVFrame;
 struct AVPacket;
 struct SwsContext;
+struct ImBufAnimKeyFrameIndex;
 #endif
 
 struct IDProperty;
@@ -57,6 +58,8 @@ struct ImBufAnim {
   int64_t cur_pts;
   int64_t cur_key_frame_pts;
   AVPacket *cur_packet;
+  /** Key frames seen while decoding, allocated when the first one is decoded. */
+  ImBufAnimKeyFrameIndex *key_frame_index;
 
   bool seek_before_decode;
 #endif
@@ -11,6 +11,8 @@
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
+#include <map>
+#include <optional>
 #include <sys/types.h>
 #ifndef _WIN32
 #  include <dirent.h>
@@ -21,6 +23,7 @@
 #include "BLI_math_base.hh"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -590,16 +593,17 @@ static void ffmpeg_postprocess(ImBufAnim *anim, AVFrame *input, ImBuf *ibuf)
     /* Decode, then do vertical flip into destination. */
     BKE_ffmpeg_sws_scale_frame(anim->img_convert_ctx, anim->pFrameRGB, input);
 
-    /* Use negative line size to do vertical image flip. */
-    const int src_linesize[4] = {-rgb_linesize, 0, 0, 0};
-    const uint8_t *const src[4] = {
-        rgb_data + (anim->y - 1) * rgb_linesize, nullptr, nullptr, nullptr};
-    int dst_size = av_image_get_buffer_size(AVPixelFormat(anim->pFrameRGB->format),
-                                            anim->pFrameRGB->width,
-                                            anim->pFrameRGB->height,
-                                            1);
-    av_image_copy_to_buffer(
-        ibuf->byte_buffer.data, dst_size, src, src_linesize, AV_PIX_FMT_RGBA, anim->x, anim->y, 1);
+    /* The flip is a plain copy of every row, which is memory bound for large frames, so split it
+     * over multiple threads. */
+    const int64_t row_size = int64_t(anim->x) * 4;
+    blender::threading::parallel_for(
+        blender::IndexRange(anim->y), 64, [&](const blender::IndexRange rows) {
+          for (const int64_t y : rows) {
+            memcpy(ibuf->byte_buffer.data + y * row_size,
+                   rgb_data + (anim->y - 1 - y) * int64_t(rgb_linesize),
+                   row_size);
+          }
+        });
   }
 
   if (filter_y) {
@@ -653,12 +657,77 @@ static AVFrame *ffmpeg_frame_by_pts_get(ImBufAnim *anim, int64_t pts_to_search)
   return best_frame;
 }
 
+/**
+ * Key frames that were decoded so far. Formats without their own seeking functions have to search
+ * backwards for the key frame of a GOP one frame at a time, see #ffmpeg_generic_seek_workaround.
+ * Remembering the key frames makes it possible to go straight to the right one when scrubbing
+ * through parts of the movie that were played before.
+ */
+struct ImBufAnimKeyFrameIndex {
+  /**
+   * Maps the PTS of every decoded key frame to the PTS of the next key frame. The next key frame
+   * is only known when both were decoded without seeking in between, otherwise it is
+   * #AV_NOPTS_VALUE.
+   */
+  std::map<int64_t, int64_t> next_key_frame;
+  /** Most recent key frame decoded since the last seek. */
+  int64_t last_key_frame = AV_NOPTS_VALUE;
+};
+
+static void ffmpeg_key_frame_index_add(ImBufAnim *anim, const int64_t pts)
+{
+  if (pts == AV_NOPTS_VALUE) {
+    return;
+  }
+  if (anim->key_frame_index == nullptr) {
+    anim->key_frame_index = MEM_new<ImBufAnimKeyFrameIndex>(__func__);
+  }
+  ImBufAnimKeyFrameIndex &index = *anim->key_frame_index;
+  index.next_key_frame.try_emplace(pts, AV_NOPTS_VALUE);
+  if (index.last_key_frame != AV_NOPTS_VALUE && index.last_key_frame < pts) {
+    index.next_key_frame[index.last_key_frame] = pts;
+  }
+  index.last_key_frame = pts;
+}
+
+/** Key frames decoded after a seek don't follow the ones decoded before it. */
+static void ffmpeg_key_frame_index_seek_tag(ImBufAnim *anim)
+{
+  if (anim->key_frame_index != nullptr) {
+    anim->key_frame_index->last_key_frame = AV_NOPTS_VALUE;
+  }
+}
+
+/**
+ * Find the key frame of the GOP that contains \a pts_to_search. Only returns a value when the key
+ * frame and the one following it were both decoded, so it is known that there is no other key
+ * frame in between.
+ */
+static std::optional<int64_t> ffmpeg_key_frame_index_find(const ImBufAnim *anim,
+                                                          const int64_t pts_to_search)
+{
+  if (anim->key_frame_index == nullptr) {
+    return std::nullopt;
+  }
+  const std::map<int64_t, int64_t> &next_key_frame = anim->key_frame_index->next_key_frame;
+  auto it = next_key_frame.upper_bound(pts_to_search);
+  if (it == next_key_frame.begin()) {
+    return std::nullopt;
+  }
+  --it;
+  if (it->second == AV_NOPTS_VALUE) {
+    return std::nullopt;
+  }
+  return it->first;
+}
+
 static void ffmpeg_decode_store_frame_pts(ImBufAnim *anim)
 {
   anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
 
   if (anim->pFrame->key_frame) {
     anim->cur_key_frame_pts = anim->cur_pts;
+    ffmpeg_key_frame_index_add(anim, anim->cur_pts);
   }
 
   av_log(anim->pFormatCtx,
@@ -875,6 +944,35 @@ static void ffmpeg_decode_video_frame_scan(ImBufAnim *anim, int64_t pts_to_searc
   }
 }
 
+/**
+ * Seek to \a pts and read the first video packet found there.
+ * Returns false when seeking failed.
+ */
+static bool ffmpeg_seek_and_read_packet_info(ImBufAnim *anim,
+                                             const int64_t pts,
+                                             bool *r_is_key_frame,
+                                             int64_t *r_packet_pts)
+{
+  /* Seek to timestamp. */
+  if (av_seek_frame(anim->pFormatCtx, anim->videoStream, pts, AVSEEK_FLAG_BACKWARD) < 0) {
+    return false;
+  }
+
+  /* Read first video stream packet. */
+  AVPacket *read_packet = av_packet_alloc();
+  while (av_read_frame(anim->pFormatCtx, read_packet) >= 0) {
+    if (read_packet->stream_index == anim->videoStream) {
+      break;
+    }
+    av_packet_unref(read_packet);
+  }
+
+  *r_is_key_frame = read_packet->flags & AV_PKT_FLAG_KEY;
+  *r_packet_pts = timestamp_from_pts_or_dts(read_packet->pts, read_packet->dts);
+  av_packet_free(&read_packet);
+  return true;
+}
+
 /* Wrapper over av_seek_frame(), for formats that doesn't have its own read_seek() or
  * read_seek2() functions defined. When seeking in these formats, rule to seek to last
  * necessary I-frame is not honored. It is not even guaranteed that I-frame, that must be
@@ -883,38 +981,37 @@ static int ffmpeg_generic_seek_workaround(ImBufAnim *anim,
                                           int64_t *requested_pts,
                                           int64_t pts_to_search)
 {
+  bool is_key_frame;
+  int64_t cur_pts, prev_pts = -1;
+
+  /* When the key frame of the GOP was decoded before, try it directly. */
+  if (const std::optional<int64_t> key_frame_pts = ffmpeg_key_frame_index_find(anim,
+                                                                                pts_to_search))
+  {
+    if (ffmpeg_seek_and_read_packet_info(anim, *key_frame_pts, &is_key_frame, &cur_pts) &&
+        is_key_frame && cur_pts <= pts_to_search)
+    {
+      *requested_pts = *key_frame_pts;
+      return av_seek_frame(
+          anim->pFormatCtx, anim->videoStream, *key_frame_pts, AVSEEK_FLAG_BACKWARD);
+    }
+  }
+
   int64_t current_pts = *requested_pts;
   int64_t offset = 0;
 
-  int64_t cur_pts, prev_pts = -1;
-
   /* Step backward frame by frame until we find the key frame we are looking for. */
   while (current_pts != 0) {
     current_pts = *requested_pts - int64_t(round(offset * ffmpeg_steps_per_frame_get(anim)));
     current_pts = std::max(current_pts, int64_t(0));
 
-    /* Seek to timestamp. */
-    if (av_seek_frame(anim->pFormatCtx, anim->videoStream, current_pts, AVSEEK_FLAG_BACKWARD) < 0)
-    {
-      break;
-    }
-
-    /* Read first video stream packet. */
-    AVPacket *read_packet = av_packet_alloc();
-    while (av_read_frame(anim->pFormatCtx, read_packet) >= 0) {
-      if (read_packet->stream_index == anim->videoStream) {
-        break;
-      }
-      av_packet_unref(read_packet);
-    }
-
-    /* If this packet contains an I-frame, this could be the frame that we need. */
-    bool is_key_frame = read_packet->flags & AV_PKT_FLAG_KEY;
-    /* We need to check the packet timestamp as the key frame could be for a GOP forward in the
+    /* If the first packet contains an I-frame, this could be the frame that we need.
+     * We need to check the packet timestamp as the key frame could be for a GOP forward in the
      * video stream. So if it has a larger timestamp than the frame we want, ignore it.
      */
-    cur_pts = timestamp_from_pts_or_dts(read_packet->pts, read_packet->dts);
-    av_packet_free(&read_packet);
+    if (!ffmpeg_seek_and_read_packet_info(anim, current_pts, &is_key_frame, &cur_pts)) {
+      break;
+    }
 
     if (is_key_frame) {
       if (cur_pts <= pts_to_search) {
@@ -1067,6 +1164,7 @@ static int ffmpeg_seek_to_key_frame(ImBufAnim *anim,
    * errors. */
   avcodec_flush_buffers(anim->pCodecCtx);
   ffmpeg_double_buffer_backup_frame_clear(anim);
+  ffmpeg_key_frame_index_seek_tag(anim);
 
   anim->cur_pts = -1;
 
@@ -1178,6 +1276,8 @@ static void free_anim_ffmpeg(ImBufAnim *anim)
     av_frame_free(&anim->pFrameDeinterlaced);
     BKE_ffmpeg_sws_release_context(anim->img_convert_ctx);
   }
+  MEM_delete(anim->key_frame_index);
+  anim->key_frame_index = nullptr;
   anim->duration_in_frames = 0;
 }
 
@@ -2183,6 +2183,38 @@ void IMB_colormanagement_transform_from_byte(float *float_buffer,
   IMB_colormanagement_transform(
       float_buffer, width, height, channels, from_colorspace, to_colorspace, true);
 }
+/**
+ * Byte color channels converted to float independently of each other in the most common cases,
+ * without going through an OCIO processor. Returns false if the conversion needs a processor.
+ */
+static bool colormanage_byte_to_float_table(const char *from_colorspace,
+                                            const char *to_colorspace,
+                                            float r_table[256])
+{
+  bool from_srgb = false;
+  if (!STREQ(from_colorspace, to_colorspace)) {
+    ColorSpace *from_cs = colormanage_colorspace_get_named(from_colorspace);
+    ColorSpace *to_cs = colormanage_colorspace_get_named(to_colorspace);
+    if (!IMB_colormanagement_space_is_scene_linear(to_cs)) {
+      return false;
+    }
+    /* The built-in sRGB curve was verified to match the OCIO transform for all byte values when
+     * the color space info was cached. */
+    if (IMB_colormanagement_space_is_srgb(from_cs)) {
+      from_srgb = true;
+    }
+    else if (!IMB_colormanagement_space_is_scene_linear(from_cs)) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < 256; i++) {
+    const float value = float(i) * (1.0f / 255.0f);
+    r_table[i] = from_srgb ? srgb_to_linearrgb(value) : value;
+  }
+  return true;
+}
+
 void IMB_colormanagement_transform_from_byte_threaded(float *float_buffer,
                                                       uchar *byte_buffer,
                                                       int width,
@@ -2196,17 +2228,18 @@ void IMB_colormanagement_transform_from_byte_threaded(float *float_buffer,
   if (from_colorspace == nullptr || from_colorspace[0] == '\0') {
     return;
   }
-  if (STREQ(from_colorspace, to_colorspace) && channels == 4) {
-    /* Color spaces are the same, just do a simple byte->float conversion. */
+  float table[256];
+  if (channels == 4 && colormanage_byte_to_float_table(from_colorspace, to_colorspace, table)) {
+    /* Simple byte->float conversion through a lookup table. */
     int64_t pixel_count = int64_t(width) * height;
     threading::parallel_for(IndexRange(pixel_count), 256 * 1024, [&](IndexRange pix_range) {
       float *dst_ptr = float_buffer + pix_range.first() * channels;
       uchar *src_ptr = byte_buffer + pix_range.first() * channels;
       for ([[maybe_unused]] const int i : pix_range) {
-        /* Equivalent of rgba_uchar_to_float + premultiply. */
-        float cr = float(src_ptr[0]) * (1.0f / 255.0f);
-        float cg = float(src_ptr[1]) * (1.0f / 255.0f);
-        float cb = float(src_ptr[2]) * (1.0f / 255.0f);
+        /* Equivalent of rgba_uchar_to_float + transform + premultiply. */
+        float cr = table[src_ptr[0]];
+        float cg = table[src_ptr[1]];
+        float cb = table[src_ptr[2]];
         float ca = float(src_ptr[3]) * (1.0f / 255.0f);
         dst_ptr[0] = cr * ca;
         dst_ptr[1] = cg * ca;
@@ -7,8 +7,10 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
 #include <cmath>
 
+#include "BLI_array.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
@@ -776,6 +778,171 @@ static void scale_bilinear_func(
   });
 }
 
+static float filter_cubic_mitchell(float x)
+{
+  /* Mitchell-Netravali filter with B = C = 1/3. */
+  constexpr float b = 1.0f / 3.0f;
+  constexpr float c = 1.0f / 3.0f;
+  x = std::abs(x);
+  if (x < 1.0f) {
+    return ((12.0f - 9.0f * b - 6.0f * c) * x * x * x + (-18.0f + 12.0f * b + 6.0f * c) * x * x +
+            (6.0f - 2.0f * b)) /
+           6.0f;
+  }
+  if (x < 2.0f) {
+    return ((-b - 6.0f * c) * x * x * x + (6.0f * b + 30.0f * c) * x * x +
+            (-12.0f * b - 48.0f * c) * x + (8.0f * b + 24.0f * c)) /
+           6.0f;
+  }
+  return 0.0f;
+}
+
+static float filter_lanczos3(float x)
+{
+  x = std::abs(x);
+  if (x < 1e-6f) {
+    return 1.0f;
+  }
+  if (x < 3.0f) {
+    const float pi_x = float(M_PI) * x;
+    return 3.0f * std::sin(pi_x) * std::sin(pi_x / 3.0f) / (pi_x * pi_x);
+  }
+  return 0.0f;
+}
+
+/**
+ * Weights of the source pixels that contribute to each destination pixel along one axis.
+ * Computed once per axis, since the weights are the same for every row or column.
+ */
+struct FilterWeights {
+  /** Maximum number of source pixels contributing to one destination pixel. */
+  int taps;
+  /** First contributing source pixel for each destination pixel. */
+  blender::Array<int> start;
+  /** Number of contributing source pixels for each destination pixel. */
+  blender::Array<int> count;
+  /** Normalized weights, #taps per destination pixel. */
+  blender::Array<float> weights;
+};
+
+static FilterWeights filter_weights_compute(int src_size, int dst_size, IMBScaleFilter filter)
+{
+  const bool is_lanczos = filter == IMBScaleFilter::Lanczos3;
+  const float radius = is_lanczos ? 3.0f : 2.0f;
+  const float scale = float(src_size) / dst_size;
+  /* Stretch the filter when scaling down so that it also removes frequencies that can't be
+   * represented in the destination image. */
+  const float filter_scale = std::max(scale, 1.0f);
+  const float support = radius * filter_scale;
+
+  FilterWeights fw;
+  fw.taps = int(std::ceil(support)) * 2 + 1;
+  fw.start.reinitialize(dst_size);
+  fw.count.reinitialize(dst_size);
+  fw.weights = blender::Array<float>(int64_t(dst_size) * fw.taps, 0.0f);
+
+  for (int i = 0; i < dst_size; i++) {
+    const float center = (i + 0.5f) * scale;
+    const int first = std::max(int(std::floor(center - support)), 0);
+    const int last = std::min(int(std::ceil(center + support)), src_size);
+    const int count = std::min(last - first, fw.taps);
+    float *weights = &fw.weights[int64_t(i) * fw.taps];
+
+    float weight_sum = 0.0f;
+    for (int t = 0; t < count; t++) {
+      const float x = (first + t + 0.5f - center) / filter_scale;
+      weights[t] = is_lanczos ? filter_lanczos3(x) : filter_cubic_mitchell(x);
+      weight_sum += weights[t];
+    }
+    /* Normalize, which also accounts for the part of the filter outside the image. */
+    if (weight_sum != 0.0f) {
+      for (int t = 0; t < count; t++) {
+        weights[t] /= weight_sum;
+      }
+    }
+    fw.start[i] = first;
+    fw.count[i] = count;
+  }
+  return fw;
+}
+
+/* Negative lobes of the filters can overshoot, which doesn't fit in byte pixels. */
+template<typename T> static inline void store_filtered_pixel(const float4 &pix, T *ptr)
+{
+  store_pixel(pix, ptr);
+}
+static inline void store_filtered_pixel(const float4 &pix, uchar4 *ptr)
+{
+  store_pixel(blender::math::clamp(pix, 0.0f, 255.0f), ptr);
+}
+
+/**
+ * Separable filter: filter rows into an intermediate image that has the destination width, then
+ * filter its columns. The intermediate image uses floats, so byte images are only rounded once.
+ */
+template<IMBScaleFilter Filter> struct ScaleSeparable {
+  template<typename T>
+  static void op(const T *src, T *dst, int ibufx, int ibufy, int newx, int newy, bool threaded)
+  {
+    using namespace blender;
+    const FilterWeights fw_x = filter_weights_compute(ibufx, newx, Filter);
+    const FilterWeights fw_y = filter_weights_compute(ibufy, newy, Filter);
+
+    Array<float4> tmp(int64_t(newx) * ibufy);
+    int grain_size = threaded ? 32 : ibufy;
+    threading::parallel_for(IndexRange(ibufy), grain_size, [&](IndexRange range) {
+      for (const int y : range) {
+        const T *src_row = src + int64_t(y) * ibufx;
+        float4 *tmp_row = &tmp[int64_t(y) * newx];
+        for (int x = 0; x < newx; x++) {
+          const T *src_ptr = src_row + fw_x.start[x];
+          const float *weights = &fw_x.weights[int64_t(x) * fw_x.taps];
+          float4 sum(0.0f);
+          for (int t = 0; t < fw_x.count[x]; t++) {
+            sum += load_pixel(src_ptr + t) * weights[t];
+          }
+          tmp_row[x] = sum;
+        }
+      }
+    });
+
+    grain_size = threaded ? 32 : newy;
+    threading::parallel_for(IndexRange(newy), grain_size, [&](IndexRange range) {
+      /* Accumulate whole rows, so the intermediate image is read sequentially. */
+      Array<float4> row(newx);
+      for (const int y : range) {
+        const float *weights = &fw_y.weights[int64_t(y) * fw_y.taps];
+        row.fill(float4(0.0f));
+        for (int t = 0; t < fw_y.count[y]; t++) {
+          const float4 *tmp_row = &tmp[int64_t(fw_y.start[y] + t) * newx];
+          const float weight = weights[t];
+          for (int x = 0; x < newx; x++) {
+            row[x] += tmp_row[x] * weight;
+          }
+        }
+        T *dst_row = dst + int64_t(y) * newx;
+        for (int x = 0; x < newx; x++) {
+          store_filtered_pixel(row[x], dst_row + x);
+        }
+      }
+    });
+  }
+};
+
+static void scale_cubic_mitchell_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+{
+  ScaleSeparable<IMBScaleFilter::CubicMitchell> op;
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+}
+
+static void scale_lanczos3_func(
+    const ImBuf *ibuf, int newx, int newy, uchar4 *dst_byte, float *dst_float, bool threaded)
+{
+  ScaleSeparable<IMBScaleFilter::Lanczos3> op;
+  instantiate_pixel_op(op, ibuf, newx, newy, dst_byte, dst_float, threaded);
+}
+
 bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool threaded)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
@@ -795,6 +962,12 @@ bool IMB_scale(ImBuf *ibuf, uint newx, uint newy, IMBScaleFilter filter, bool th
   else if (filter == IMBScaleFilter::Box) {
     imb_scale_box(ibuf, newx, newy, threaded);
   }
+  else if (filter == IMBScaleFilter::CubicMitchell) {
+    scale_with_function(ibuf, newx, newy, scale_cubic_mitchell_func, threaded);
+  }
+  else if (filter == IMBScaleFilter::Lanczos3) {
+    scale_with_function(ibuf, newx, newy, scale_lanczos3_func, threaded);
+  }
   else {
     BLI_assert_unreachable();
     return false;
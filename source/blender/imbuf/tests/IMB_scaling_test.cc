@@ -294,4 +294,60 @@ TEST(imbuf_scaling, threaded_2x_smaller_fl4)
   IMB_freeImBuf(res);
 }
 
+static ImBuf *create_constant_test_image(bool use_float)
+{
+  ImBuf *img = IMB_allocImBuf(9, 7, 32, use_float ? IB_rectfloat : IB_rect);
+  for (int i = 0; i < img->x * img->y; i++) {
+    if (use_float) {
+      reinterpret_cast<float4 *>(img->float_buffer.data)[i] = float4(0.25f, 0.5f, 1.5f, 1.0f);
+    }
+    else {
+      reinterpret_cast<uchar4 *>(img->byte_buffer.data)[i] = uchar4(10, 128, 250, 255);
+    }
+  }
+  return img;
+}
+
+TEST(imbuf_scaling, separable_filters_keep_constant_color)
+{
+  for (const IMBScaleFilter filter : {IMBScaleFilter::CubicMitchell, IMBScaleFilter::Lanczos3}) {
+    for (const int2 size : {int2(3, 2), int2(1, 1), int2(20, 15), int2(4, 13)}) {
+      ImBuf *img = create_constant_test_image(false);
+      IMB_scale(img, size.x, size.y, filter, true);
+      ASSERT_EQ(img->x, size.x);
+      ASSERT_EQ(img->y, size.y);
+      const uchar4 *got = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+      for (int i = 0; i < img->x * img->y; i++) {
+        EXPECT_EQ(got[i], uchar4(10, 128, 250, 255));
+      }
+      IMB_freeImBuf(img);
+
+      img = create_constant_test_image(true);
+      IMB_scale(img, size.x, size.y, filter, false);
+      const float4 *got_fl = reinterpret_cast<float4 *>(img->float_buffer.data);
+      for (int i = 0; i < img->x * img->y; i++) {
+        EXPECT_V4_NEAR(got_fl[i], float4(0.25f, 0.5f, 1.5f, 1.0f), EPS);
+      }
+      IMB_freeImBuf(img);
+    }
+  }
+}
+
+TEST(imbuf_scaling, lanczos3_byte_clamps_overshoot)
+{
+  /* A hard edge from black to white makes the filter overshoot on both sides. */
+  ImBuf *img = IMB_allocImBuf(8, 1, 32, IB_rect);
+  uchar4 *col = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+  for (int x = 0; x < img->x; x++) {
+    col[x] = x < 4 ? uchar4(0, 0, 0, 255) : uchar4(255, 255, 255, 255);
+  }
+  IMB_scale(img, 24, 1, IMBScaleFilter::Lanczos3, false);
+  const uchar4 *got = reinterpret_cast<uchar4 *>(img->byte_buffer.data);
+  EXPECT_EQ(got[8], uchar4(0, 0, 0, 255));
+  EXPECT_EQ(got[9], uchar4(0, 0, 0, 255));
+  EXPECT_EQ(got[14], uchar4(255, 255, 255, 255));
+  EXPECT_EQ(got[15], uchar4(255, 255, 255, 255));
+  IMB_freeImBuf(img);
+}
+
 }  // namespace blender::imbuf::tests
@@ -100,6 +100,22 @@ static void imb_scale_box(ImBuf *&src, int width, int height)
 {
   IMB_scale(src, width, height, IMBScaleFilter::Box, true);
 }
+static void imb_scale_cubic_st(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::CubicMitchell, false);
+}
+static void imb_scale_cubic(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::CubicMitchell, true);
+}
+static void imb_scale_lanczos_st(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::Lanczos3, false);
+}
+static void imb_scale_lanczos(ImBuf *&src, int width, int height)
+{
+  IMB_scale(src, width, height, IMBScaleFilter::Lanczos3, true);
+}
 
 static void scale_perf_impl(const char *name,
                             bool use_float,
@@ -129,6 +145,12 @@ static void test_scaling_perf(bool use_float)
   scale_perf_impl("scale_boxfl_s", use_float, imb_scale_box_st);
   scale_perf_impl("scale_boxfl_m", use_float, imb_scale_box);
   scale_perf_impl("xform_boxfl_m", use_float, imb_xform_box);
+
+  scale_perf_impl("scale_cubic_s", use_float, imb_scale_cubic_st);
+  scale_perf_impl("scale_cubic_m", use_float, imb_scale_cubic);
+
+  scale_perf_impl("scale_lancz_s", use_float, imb_scale_lanczos_st);
+  scale_perf_impl("scale_lancz_m", use_float, imb_scale_lanczos);
 }
 
 TEST(imbuf_scaling, scaling_perf_byte)
@@ -6,6 +6,7 @@
 
 #include "BKE_image.h"
 
+#include "BLI_math_color.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_threads.h"
 
@@ -53,6 +54,14 @@ class ImageFieldsFunction : public mf::MultiFunction {
   ImageUser image_user_;
   void *image_lock_;
   ImBuf *image_buffer_;
+  /**
+   * Sample the byte buffer directly instead of adding a float copy of the image, which would take
+   * four times as much memory and stay around as long as the image buffer.
+   */
+  bool use_byte_buffer_ = false;
+  bool byte_buffer_premultiply_ = false;
+  /** Scene linear value of every byte value, used when sampling the byte buffer. */
+  float byte_to_float_[256];
 
  public:
   ImageFieldsFunction(const int8_t interpolation,
@@ -79,7 +88,25 @@ class ImageFieldsFunction : public mf::MultiFunction {
       throw std::runtime_error("cannot acquire image buffer");
     }
 
-    if (image_buffer_->float_buffer.data == nullptr) {
+    if (image_buffer_->float_buffer.data == nullptr && image_buffer_->byte_buffer.data != nullptr)
+    {
+      /* Only color spaces that convert to scene linear per channel can be sampled directly, other
+       * ones need OCIO. */
+      ColorSpace *colorspace = image_buffer_->byte_buffer.colorspace;
+      const bool is_data = IMB_colormanagement_space_is_data(colorspace);
+      const bool is_srgb = !is_data && IMB_colormanagement_space_is_srgb(colorspace);
+      if (is_data || is_srgb || IMB_colormanagement_space_is_scene_linear(colorspace)) {
+        use_byte_buffer_ = true;
+        /* Match #IMB_float_from_rect. */
+        byte_buffer_premultiply_ = IMB_alpha_affects_rgb(image_buffer_);
+        for (int i = 0; i < 256; i++) {
+          const float value = float(i) * (1.0f / 255.0f);
+          byte_to_float_[i] = is_srgb ? srgb_to_linearrgb(value) : value;
+        }
+      }
+    }
+
+    if (!use_byte_buffer_ && image_buffer_->float_buffer.data == nullptr) {
       BLI_thread_lock(LOCK_IMAGE);
       if (!image_buffer_->float_buffer.data) {
         IMB_float_from_rect(image_buffer_);
@@ -87,7 +114,7 @@ class ImageFieldsFunction : public mf::MultiFunction {
       BLI_thread_unlock(LOCK_IMAGE);
     }
 
-    if (image_buffer_->float_buffer.data == nullptr) {
+    if (!use_byte_buffer_ && image_buffer_->float_buffer.data == nullptr) {
       BKE_image_release_ibuf(&image_, image_buffer_, image_lock_);
       throw std::runtime_error("cannot get float buffer");
     }
@@ -121,11 +148,20 @@ class ImageFieldsFunction : public mf::MultiFunction {
     return m;
   }
 
-  static float4 image_pixel_lookup(const ImBuf &ibuf, const int px, const int py)
+  float4 image_pixel_lookup(const ImBuf &ibuf, const int px, const int py) const
   {
     if (px < 0 || py < 0 || px >= ibuf.x || py >= ibuf.y) {
       return float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
+    if (use_byte_buffer_) {
+      const uchar *pixel = ibuf.byte_buffer.data + (int64_t(px) + int64_t(py) * ibuf.x) * 4;
+      const float alpha = float(pixel[3]) * (1.0f / 255.0f);
+      const float rgb_factor = byte_buffer_premultiply_ ? alpha : 1.0f;
+      return float4(byte_to_float_[pixel[0]] * rgb_factor,
+                    byte_to_float_[pixel[1]] * rgb_factor,
+                    byte_to_float_[pixel[2]] * rgb_factor,
+                    alpha);
+    }
     return ((const float4 *)ibuf.float_buffer.data)[px + py * ibuf.x];
   }
 
@@ -136,10 +172,10 @@ class ImageFieldsFunction : public mf::MultiFunction {
     return x - float(i);
   }
 
-  static float4 image_cubic_texture_lookup(const ImBuf &ibuf,
-                                           const float px,
-                                           const float py,
-                                           const int extension)
+  float4 image_cubic_texture_lookup(const ImBuf &ibuf,
+                                    const float px,
+                                    const float py,
+                                    const int extension) const
   {
     const int width = ibuf.x;
     const int height = ibuf.y;
@@ -227,10 +263,10 @@ class ImageFieldsFunction : public mf::MultiFunction {
                     u[3] * image_pixel_lookup(ibuf, xc[3], yc[3])));
   }
 
-  static float4 image_linear_texture_lookup(const ImBuf &ibuf,
-                                            const float px,
-                                            const float py,
-                                            const int8_t extension)
+  float4 image_linear_texture_lookup(const ImBuf &ibuf,
+                                     const float px,
+                                     const float py,
+                                     const int8_t extension) const
   {
     const int width = ibuf.x;
     const int height = ibuf.y;
@@ -275,10 +311,10 @@ class ImageFieldsFunction : public mf::MultiFunction {
            image_pixel_lookup(ibuf, nix, niy) * nfx * nfy;
   }
 
-  static float4 image_closest_texture_lookup(const ImBuf &ibuf,
-                                             const float px,
-                                             const float py,
-                                             const int extension)
+  float4 image_closest_texture_lookup(const ImBuf &ibuf,
+                                      const float px,
+                                      const float py,
+                                      const int extension) const
   {
     const int width = ibuf.x;
     const int height = ibuf.y;
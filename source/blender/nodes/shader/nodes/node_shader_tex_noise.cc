@@ -340,7 +340,36 @@ class NoiseFunction : public mf::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        const bool uniform_parameters = detail.is_single() && roughness.is_single() &&
+                                        lacunarity.is_single() && offset.is_single() &&
+                                        gain.is_single() && distortion.is_single();
+        if (compute_factor && uniform_parameters) {
+          /* Evaluate many positions at once, which allows using SIMD instructions. */
+          static constexpr int64_t batch_size = 256;
+          std::array<float3, batch_size> positions;
+          std::array<float, batch_size> values;
+          for (int64_t start = 0; start < mask.size(); start += batch_size) {
+            const IndexMask batch_mask = mask.slice(start,
+                                                    std::min(batch_size, mask.size() - start));
+            const int64_t size = batch_mask.size();
+            batch_mask.foreach_index([&](const int64_t i, const int64_t pos) {
+              positions[pos] = vector[i] * scale[i];
+            });
+            noise::perlin_fractal_distorted(Span(positions.data(), size),
+                                            math::clamp(detail.get_internal_single(), 0.0f, 15.0f),
+                                            math::max(roughness.get_internal_single(), 0.0f),
+                                            lacunarity.get_internal_single(),
+                                            offset.get_internal_single(),
+                                            gain.get_internal_single(),
+                                            distortion.get_internal_single(),
+                                            type_,
+                                            normalize_,
+                                            MutableSpan(values.data(), size));
+            batch_mask.foreach_index(
+                [&](const int64_t i, const int64_t pos) { r_factor[i] = values[pos]; });
+          }
+        }
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position = vector[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(position,
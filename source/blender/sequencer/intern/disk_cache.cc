@@ -47,6 +47,8 @@
  * ZLIB compression with user definable level can be used to compress image data(per image)
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
+ * Headers of files that were accessed are kept in memory, so lookups of images that are not
+ * cached don't have to read them again.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
  * size specified in user preferences.
  * To distinguish 2 blend files with same name, scene->ed->disk_cache_timestamp
@@ -93,6 +95,11 @@ struct DiskCacheFile {
   int render_size;
   int view_id;
   int start_frame;
+  /**
+   * Copy of the header stored in the file, read when the file is first accessed. Used to find out
+   * whether an image is cached without touching the file system.
+   */
+  DiskCacheHeader *header;
 };
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -208,11 +215,20 @@ static DiskCacheFile *seq_disk_cache_get_oldest_file(SeqDiskCache *disk_cache)
   return oldest_file;
 }
 
+static void seq_disk_cache_free_files(SeqDiskCache *disk_cache)
+{
+  LISTBASE_FOREACH (DiskCacheFile *, cache_file, &disk_cache->files) {
+    MEM_SAFE_FREE(cache_file->header);
+  }
+  BLI_freelistN(&disk_cache->files);
+}
+
 static void seq_disk_cache_delete_file(SeqDiskCache *disk_cache, DiskCacheFile *file)
 {
   disk_cache->size_total -= file->fstat.st_size;
   BLI_delete(file->filepath, false, false);
   BLI_remlink(&disk_cache->files, file);
+  MEM_SAFE_FREE(file->header);
   MEM_freeN(file);
 }
 
@@ -230,7 +246,7 @@ bool seq_disk_cache_enforce_limits(SeqDiskCache *disk_cache)
 
     if (BLI_exists(oldest_file->filepath) == 0) {
       /* File may have been manually deleted during runtime, do re-scan. */
-      BLI_freelistN(&disk_cache->files);
+      seq_disk_cache_free_files(disk_cache);
       seq_disk_cache_get_files(disk_cache, seq_disk_cache_base_dir());
       continue;
     }
@@ -541,6 +557,15 @@ static int seq_disk_cache_get_header_entry(const SeqCacheKey *key, const DiskCac
   return -1;
 }
 
+static void seq_disk_cache_store_header(DiskCacheFile *cache_file, const DiskCacheHeader *header)
+{
+  if (cache_file->header == nullptr) {
+    cache_file->header = static_cast<DiskCacheHeader *>(
+        MEM_mallocN(sizeof(DiskCacheHeader), "SeqDiskCacheHeader"));
+  }
+  memcpy(cache_file->header, header, sizeof(DiskCacheHeader));
+}
+
 bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
 {
   BLI_mutex_lock(&disk_cache->read_write_mutex);
@@ -583,6 +608,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
      */
     header.entry[entry_index].size_compressed = bytes_written;
     seq_disk_cache_write_header(file, &header);
+    seq_disk_cache_store_header(cache_file, &header);
     seq_disk_cache_update_file(disk_cache, filepath);
     fclose(file);
 
@@ -602,7 +628,17 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   DiskCacheHeader header;
 
   seq_disk_cache_get_file_path(disk_cache, key, filepath, sizeof(filepath));
-  BLI_file_ensure_parent_dir_exists(filepath);
+
+  /* All cache files are known, either from scanning the cache directory or from writing them.
+   * Avoid opening files that don't exist or don't contain the image. */
+  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, filepath);
+  if (cache_file == nullptr ||
+      (cache_file->header != nullptr &&
+       seq_disk_cache_get_header_entry(key, cache_file->header) < 0))
+  {
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    return nullptr;
+  }
 
   FILE *file = BLI_fopen(filepath, "rb");
   if (!file) {
@@ -615,6 +651,7 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     BLI_mutex_unlock(&disk_cache->read_write_mutex);
     return nullptr;
   }
+  seq_disk_cache_store_header(cache_file, &header);
   int entry_index = seq_disk_cache_get_header_entry(key, &header);
 
   /* Item not found. */
@@ -679,7 +716,7 @@ SeqDiskCache *seq_disk_cache_create(Main *bmain, Scene *scene)
 
 void seq_disk_cache_free(SeqDiskCache *disk_cache)
 {
-  BLI_freelistN(&disk_cache->files);
+  seq_disk_cache_free_files(disk_cache);
   BLI_mutex_end(&disk_cache->read_write_mutex);
   MEM_freeN(disk_cache);
 }
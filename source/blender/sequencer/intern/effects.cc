@@ -20,6 +20,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_simd.hh"
 #include "BLI_string.h"
 #include "BLI_task.hh"
 #include "BLI_threads.h"
@@ -106,11 +107,34 @@ static void slice_get_float_buffers(const SeqRenderData *context,
   }
 }
 
+/* The byte versions below are used for every pixel of the blend effects. They give the same
+ * results as #straight_uchar_to_premul_float and #premul_float_to_straight_uchar, but convert all
+ * four channels at once. */
+
 static float4 load_premul_pixel(const uchar *ptr)
 {
+#if BLI_HAVE_SSE2
+  int32_t packed;
+  memcpy(&packed, ptr, sizeof(packed));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i rgba_i16 = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packed), zero);
+  const __m128 rgba = _mm_cvtepi32_ps(_mm_unpacklo_epi16(rgba_i16, zero));
+
+  /* RGB are multiplied by `alpha / 255`, alpha itself by `1 / 255`. */
+  const __m128 inv_255 = _mm_set1_ps(1.0f / 255.0f);
+  const __m128 alpha = _mm_mul_ps(_mm_shuffle_ps(rgba, rgba, _MM_SHUFFLE(3, 3, 3, 3)), inv_255);
+  const __m128 fac = _mm_mul_ps(alpha, inv_255);
+  const __m128 fac_inv_255 = _mm_shuffle_ps(
+      fac, _mm_shuffle_ps(fac, inv_255, _MM_SHUFFLE(0, 0, 3, 3)), _MM_SHUFFLE(2, 0, 1, 0));
+
+  float4 res;
+  _mm_storeu_ps(res, _mm_mul_ps(rgba, fac_inv_255));
+  return res;
+#else
   float4 res;
   straight_uchar_to_premul_float(res, ptr);
   return res;
+#endif
 }
 
 static float4 load_premul_pixel(const float *ptr)
@@ -120,7 +144,29 @@ static float4 load_premul_pixel(const float *ptr)
 
 static void store_premul_pixel(const float4 &pix, uchar *dst)
 {
+#if BLI_HAVE_SSE2
+  const __m128 rgba = _mm_loadu_ps(pix);
+  const __m128 one = _mm_set1_ps(1.0f);
+
+  /* Un-premultiply RGB, unless alpha is zero or one. Alpha itself is kept as is. */
+  const float alpha = pix.w;
+  const __m128 alpha_inv = (alpha == 0.0f || alpha == 1.0f) ?
+                               one :
+                               _mm_div_ps(one, _mm_set1_ps(alpha));
+  const __m128 alpha_inv_one = _mm_shuffle_ps(
+      alpha_inv, _mm_shuffle_ps(alpha_inv, one, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+  const __m128 straight = _mm_mul_ps(rgba, alpha_inv_one);
+
+  /* Same rounding and clamping as #unit_float_to_uchar_clamp. */
+  const __m128 scaled = _mm_add_ps(_mm_mul_ps(straight, _mm_set1_ps(255.0f)), _mm_set1_ps(0.5f));
+  const __m128 clamped = _mm_min_ps(_mm_max_ps(scaled, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+  const __m128i rgba_i32 = _mm_cvttps_epi32(clamped);
+  const __m128i rgba_i16 = _mm_packs_epi32(rgba_i32, rgba_i32);
+  const int32_t packed = _mm_cvtsi128_si32(_mm_packus_epi16(rgba_i16, rgba_i16));
+  memcpy(dst, &packed, sizeof(packed));
+#else
   premul_float_to_straight_uchar(dst, pix);
+#endif
 }
 
 static void store_premul_pixel(const float4 &pix, float *dst)
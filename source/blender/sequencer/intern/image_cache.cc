@@ -64,7 +64,12 @@
 struct SeqCache {
   Main *bmain;
   GHash *hash;
-  ThreadMutex iterator_mutex;
+  /**
+   * Lookups only read the hash and take this lock in read mode, so the UI thread and prefetch
+   * threads don't serialize on cache hits. Everything that modifies the cache, including the key
+   * linking, takes it in write mode.
+   */
+  ThreadRWMutex iterator_mutex;
   BLI_mempool *keys_pool;
   BLI_mempool *items_pool;
   SeqCacheKey *last_key;
@@ -157,7 +162,17 @@ static void seq_cache_lock(Scene *scene)
   SeqCache *cache = seq_cache_get_from_scene(scene);
 
   if (cache) {
-    BLI_mutex_lock(&cache->iterator_mutex);
+    BLI_rw_mutex_lock(&cache->iterator_mutex, THREAD_LOCK_WRITE);
+  }
+}
+
+/** Lock the cache for lookups that don't modify it. Multiple readers can hold the lock. */
+static void seq_cache_lock_read(Scene *scene)
+{
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+
+  if (cache) {
+    BLI_rw_mutex_lock(&cache->iterator_mutex, THREAD_LOCK_READ);
   }
 }
 
@@ -166,7 +181,7 @@ static void seq_cache_unlock(Scene *scene)
   SeqCache *cache = seq_cache_get_from_scene(scene);
 
   if (cache) {
-    BLI_mutex_unlock(&cache->iterator_mutex);
+    BLI_rw_mutex_unlock(&cache->iterator_mutex);
   }
 }
 
@@ -192,11 +207,11 @@ static void seq_cache_valfree(void *val)
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
-static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
+static int get_stored_types_flag(const Scene *scene, const Sequence *seq)
 {
   int flag;
-  if (key->seq->cache_flag & SEQ_CACHE_OVERRIDE) {
-    flag = key->seq->cache_flag;
+  if (seq->cache_flag & SEQ_CACHE_OVERRIDE) {
+    flag = seq->cache_flag;
   }
   else {
     flag = scene->ed->cache_flag;
@@ -216,7 +231,7 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item->cache_owner = cache;
   item->ibuf = ibuf;
 
-  const int stored_types_flag = get_stored_types_flag(scene, key);
+  const int stored_types_flag = get_stored_types_flag(scene, key->seq);
 
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
@@ -496,7 +511,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
     cache->last_key = nullptr;
     cache->bmain = bmain;
-    BLI_mutex_init(&cache->iterator_mutex);
+    BLI_rw_mutex_init(&cache->iterator_mutex);
     scene->ed->cache = cache;
 
     if (scene->ed->disk_cache_timestamp == 0) {
@@ -583,7 +598,7 @@ void seq_cache_destruct(Scene *scene)
   BLI_ghash_free(cache->hash, seq_cache_keyfree, seq_cache_valfree);
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
-  BLI_mutex_end(&cache->iterator_mutex);
+  BLI_rw_mutex_end(&cache->iterator_mutex);
 
   if (cache->disk_cache != nullptr) {
     seq_disk_cache_free(cache->disk_cache);
@@ -707,7 +722,7 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
     seq_cache_create(context->bmain, scene);
   }
 
-  seq_cache_lock(scene);
+  seq_cache_lock_read(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   ImBuf *ibuf = nullptr;
   SeqCacheKey key;
@@ -737,14 +752,40 @@ ImBuf *seq_cache_get(const SeqRenderData *context, Sequence *seq, float timeline
 
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
-      SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-      seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_lock(scene);
+      /* Another thread may have stored the same image since the lookup above. */
+      if (!BLI_ghash_haskey(cache->hash, &key)) {
+        SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+        seq_cache_put_ex(scene, new_key, ibuf);
+      }
+      seq_cache_unlock(scene);
     }
   }
 
   return ibuf;
 }
 
+bool seq_cache_is_type_stored(const SeqRenderData *context, Sequence *seq, const int type)
+{
+  if (context->skip_cache || context->is_proxy_render || context->for_render || !seq) {
+    return false;
+  }
+
+  Scene *scene = context->scene;
+
+  if (context->is_prefetch_render) {
+    context = seq_prefetch_get_original_context(context);
+    scene = context->scene;
+    seq = seq_prefetch_get_original_sequence(seq, scene);
+  }
+
+  if (!seq || !scene->ed) {
+    return false;
+  }
+
+  return (get_stored_types_flag(scene, seq) & type) != 0;
+}
+
 bool seq_cache_put_if_possible(
     const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf)
 {
@@ -805,6 +846,13 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+  /* Strips can be rendered from multiple threads, another one may have stored this image since
+   * the lookup above. */
+  if (BLI_ghash_haskey(cache->hash, key)) {
+    BLI_mempool_free(cache->keys_pool, key);
+    seq_cache_unlock(scene);
+    return;
+  }
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
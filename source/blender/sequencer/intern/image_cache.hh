@@ -37,6 +37,11 @@ void seq_cache_put(
     const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *i);
 bool seq_cache_put_if_possible(
     const SeqRenderData *context, Sequence *seq, float timeline_frame, int type, ImBuf *ibuf);
+/**
+ * Check whether images of the given type are kept in the cache for this strip, rather than only
+ * being stored temporarily while the current frame is rendered.
+ */
+bool seq_cache_is_type_stored(const SeqRenderData *context, Sequence *seq, int type);
 /**
  * Find only "base" keys.
  * Sources(other types) for a frame must be freed all at once.
@@ -1944,6 +1944,213 @@ static bool is_opaque_alpha_over(const Sequence *seq)
   return true;
 }
 
+static bool seq_blend_can_be_tiled(Sequence *seq)
+{
+  /* Drop reads pixels of other rows of the image below it, which may not be blended yet. */
+  if (seq->blend_mode == SEQ_TYPE_OVERDROP) {
+    return false;
+  }
+  const SeqEffectHandle sh = seq_effect_get_sequence_blend(seq);
+  return sh.multithreaded && sh.execute_slice != nullptr;
+}
+
+/**
+ * Whether rendering the strip only accesses data owned by the strip itself, so that it can be
+ * rendered at the same time as other strips. Modifier masks are rendered from other strips or mask
+ * data-blocks, which may be shared with other strips in the stack.
+ */
+static bool seq_render_strip_is_self_contained(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (const SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->flag & SEQUENCE_MODIFIER_MUTE) {
+      continue;
+    }
+    if (smd->mask_input_type == SEQUENCE_MASK_INPUT_STRIP && smd->mask_sequence != nullptr) {
+      return false;
+    }
+    if (smd->mask_input_type == SEQUENCE_MASK_INPUT_ID && smd->mask_id != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Whether \a seq is rendered and blended over the image below it, when compositing the stack
+ * upwards from the bottom-most strip that is used.
+ */
+static bool seq_render_strip_stack_is_blended(const SeqRenderData *context,
+                                              const OpaqueQuadTracker &opaques,
+                                              Sequence *seq,
+                                              const int64_t order_index)
+{
+  return !opaques.is_occluded(context, seq, order_index) &&
+         seq_get_early_out_for_blend_mode(seq) == StripEarlyOut::DoEffect;
+}
+
+/**
+ * Render the strips that are blended over the bottom of the stack in parallel, so their images
+ * are already cached when the stack is composited. Reading and decoding the media of each channel
+ * is otherwise done one strip after another, which leaves most cores idle while prefetching frames
+ * with many channels. Strips that end up not being used for the frame are skipped, and only
+ * strips that don't depend on other strips or data-blocks are rendered here, see
+ * #seq_render_strip_is_self_contained.
+ */
+static void seq_render_strip_stack_inputs_parallel(const SeqRenderData *context,
+                                                   const Span<Sequence *> strips,
+                                                   const OpaqueQuadTracker &opaques,
+                                                   const int64_t start,
+                                                   const float timeline_frame)
+{
+  Vector<Sequence *> inputs;
+  for (int64_t i = start; i < strips.size(); i++) {
+    Sequence *seq = strips[i];
+    if (seq_render_strip_stack_is_blended(context, opaques, seq, i) &&
+        seq_render_strip_is_self_contained(seq))
+    {
+      inputs.append(seq);
+    }
+  }
+
+  if (inputs.size() < 2) {
+    return;
+  }
+
+  /* Rendering happens while the render mutex is locked, so the current thread must not start
+   * working on unrelated tasks while waiting for the strips. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(inputs.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        SeqRenderState state;
+        IMB_freeImBuf(seq_render_strip(context, &state, inputs[i], timeline_frame));
+      }
+    });
+  });
+}
+
+/**
+ * Number of strips starting at \a start that can be blended over the image below them in one
+ * tiled pass. Only the composite of the last strip of such a run is created, so the composites of
+ * the other strips must not be kept in the cache.
+ */
+static int64_t seq_render_strip_stack_tiled_run_size(const SeqRenderData *context,
+                                                     const Span<Sequence *> strips,
+                                                     const OpaqueQuadTracker &opaques,
+                                                     const int64_t start)
+{
+  int64_t i = start;
+  while (i < strips.size()) {
+    Sequence *seq = strips[i];
+    if (!seq_render_strip_stack_is_blended(context, opaques, seq, i) ||
+        !seq_blend_can_be_tiled(seq))
+    {
+      break;
+    }
+    i++;
+    if (seq_cache_is_type_stored(context, seq, SEQ_CACHE_STORE_COMPOSITE)) {
+      break;
+    }
+  }
+  return i - start;
+}
+
+/**
+ * Blend all \a strips over \a ibuf_below, one after another. Instead of blending whole frames
+ * pairwise, the image is processed in tiles of a few rows that are blended with every strip while
+ * they are still in the CPU cache. The intermediate results alternate between two buffers, so only
+ * two images are allocated no matter how many strips are blended.
+ */
+static ImBuf *seq_render_strip_stack_blend_tiled(const SeqRenderData *context,
+                                                 SeqRenderState *state,
+                                                 const Span<Sequence *> strips,
+                                                 const float timeline_frame,
+                                                 ImBuf *ibuf_below)
+{
+  Array<ImBuf *> inputs(strips.size());
+  for (const int64_t i : strips.index_range()) {
+    inputs[i] = seq_render_strip(context, state, strips[i], timeline_frame);
+  }
+
+  /* The effects convert their inputs to float as soon as one of them is float. To give the same
+   * result as blending the strips one by one, only blend in tiles when that doesn't happen
+   * part-way through the stack. */
+  const bool use_float = ibuf_below->float_buffer.data != nullptr;
+  bool same_format = true;
+  for (const ImBuf *ibuf : inputs) {
+    same_format &= (ibuf->float_buffer.data != nullptr) == use_float;
+  }
+
+  ImBuf *out = ibuf_below;
+  if (!same_format) {
+    for (const int64_t i : strips.index_range()) {
+      ImBuf *ibuf1 = out;
+      out = seq_render_strip_stack_apply_effect(
+          context, strips[i], timeline_frame, ibuf1, inputs[i]);
+      IMB_freeImBuf(ibuf1);
+      IMB_freeImBuf(inputs[i]);
+    }
+    return out;
+  }
+
+  Array<SeqEffectHandle> handles(strips.size());
+  Array<float> facs(strips.size());
+  Array<bool> swap_inputs(strips.size());
+  for (const int64_t i : strips.index_range()) {
+    handles[i] = seq_effect_get_sequence_blend(strips[i]);
+    facs[i] = strips[i]->blend_opacity / 100.0f;
+    swap_inputs[i] = seq_must_swap_input_in_blend_mode(strips[i]);
+  }
+
+  const std::array<ImBuf *, 2> buffers = {
+      handles[0].init_execution(context, ibuf_below, inputs[0]),
+      handles[0].init_execution(context, ibuf_below, inputs[0]),
+  };
+
+  /* Aim for tiles of all blended images to fit in the L2 cache. */
+  const int64_t row_size = int64_t(buffers[0]->x) * 4 *
+                           (use_float ? sizeof(float) : sizeof(uchar));
+  const int64_t tile_rows = std::max<int64_t>(1, (256 * 1024) / (row_size * 3));
+
+  /* The stack is blended while the render mutex is locked, so the current thread must not start
+   * working on unrelated tasks while waiting for the tiles. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(IndexRange(buffers[0]->y), tile_rows, [&](const IndexRange rows) {
+      for (int64_t tile_start = rows.start(); tile_start < rows.one_after_last();
+           tile_start += tile_rows)
+      {
+        const int tile_size = int(std::min(tile_rows, rows.one_after_last() - tile_start));
+        const ImBuf *below = ibuf_below;
+        for (const int64_t i : strips.index_range()) {
+          ImBuf *dst = buffers[i % 2];
+          const ImBuf *ibuf1 = swap_inputs[i] ? inputs[i] : below;
+          const ImBuf *ibuf2 = swap_inputs[i] ? below : inputs[i];
+          handles[i].execute_slice(context,
+                                   strips[i],
+                                   timeline_frame,
+                                   facs[i],
+                                   ibuf1,
+                                   ibuf2,
+                                   int(tile_start),
+                                   tile_size,
+                                   dst);
+          below = dst;
+        }
+      }
+    });
+  });
+
+  out = buffers[(strips.size() - 1) % 2];
+  IMB_freeImBuf(buffers[strips.size() % 2]);
+  IMB_freeImBuf(ibuf_below);
+  for (ImBuf *ibuf : inputs) {
+    IMB_freeImBuf(ibuf);
+  }
+  return out;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -2046,9 +2253,23 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
   }
 
   i++;
+  if (context->is_prefetch_render) {
+    seq_render_strip_stack_inputs_parallel(context, strips, opaques, i, timeline_frame);
+  }
   for (; i < strips.size(); i++) {
     Sequence *seq = strips[i];
 
+    const int64_t tiled_num = out ? seq_render_strip_stack_tiled_run_size(
+                                        context, strips, opaques, i) :
+                                    0;
+    if (tiled_num > 1) {
+      out = seq_render_strip_stack_blend_tiled(
+          context, state, strips.as_span().slice(i, tiled_num), timeline_frame, out);
+      i += tiled_num - 1;
+      seq_cache_put(context, strips[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
+      continue;
+    }
+
     if (opaques.is_occluded(context, seq, i)) {
       continue;
     }